@@ -0,0 +1,7 @@
+DELETE FROM `rbac_permissions` WHERE `id`=835;
+INSERT INTO `rbac_permissions` (`id`, `name`) VALUES
+(835, 'Command: debug auraupdates');
+
+DELETE FROM `rbac_linked_permissions` WHERE `linkedId`=835;
+INSERT INTO `rbac_linked_permissions` (`id`, `linkedId`) VALUES
+(192, 835);
@@ -0,0 +1,7 @@
+DELETE FROM `rbac_permissions` WHERE `id`=837;
+INSERT INTO `rbac_permissions` (`id`, `name`) VALUES
+(837, 'Command: debug packetstats');
+
+DELETE FROM `rbac_linked_permissions` WHERE `linkedId`=837;
+INSERT INTO `rbac_linked_permissions` (`id`, `linkedId`) VALUES
+(192, 837);
@@ -0,0 +1,7 @@
+DELETE FROM `rbac_permissions` WHERE `id`=838;
+INSERT INTO `rbac_permissions` (`id`, `name`) VALUES
+(838, 'Command: debug charcache');
+
+DELETE FROM `rbac_linked_permissions` WHERE `linkedId`=838;
+INSERT INTO `rbac_linked_permissions` (`id`, `linkedId`) VALUES
+(192, 838);
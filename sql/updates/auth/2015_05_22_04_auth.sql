@@ -0,0 +1,7 @@
+DELETE FROM `rbac_permissions` WHERE `id`=839;
+INSERT INTO `rbac_permissions` (`id`, `name`) VALUES
+(839, 'Command: debug achievementstats');
+
+DELETE FROM `rbac_linked_permissions` WHERE `linkedId`=839;
+INSERT INTO `rbac_linked_permissions` (`id`, `linkedId`) VALUES
+(192, 839);
@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug auraupdates';
+INSERT INTO `command` (`name`, `permission`, `help`) VALUES
+('debug auraupdates', 835, 'Syntax: .debug auraupdates\nShow how many owned aura updates were done and skipped by the aura update scheduler since server start.');
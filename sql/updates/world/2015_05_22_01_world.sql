@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug procstats';
+INSERT INTO `command` (`name`, `permission`, `help`) VALUES
+('debug procstats', 836, 'Syntax: .debug procstats\nShow how many proc events were handled and how many auras were evaluated or skipped for them since server start.');
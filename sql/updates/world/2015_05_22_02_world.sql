@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug packetstats';
+INSERT INTO `command` (`name`, `permission`, `help`) VALUES
+('debug packetstats', 837, 'Syntax: .debug packetstats [#count]\nShow packet storage pool usage and allocation counters of the #count (default 10) most created server opcodes.');
@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug charcache';
+INSERT INTO `command` (`name`, `permission`, `help`) VALUES
+('debug charcache', 838, 'Syntax: .debug charcache\nShow size, memory use and hit/miss counters of the character info cache.');
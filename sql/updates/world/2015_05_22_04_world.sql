@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='debug achievementstats';
+INSERT INTO `command` (`name`, `permission`, `help`) VALUES
+('debug achievementstats', 839, 'Syntax: .debug achievementstats\nShow how many achievement criteria are evaluated per criteria update and how many the type/asset index and completed achievements let the server skip.');
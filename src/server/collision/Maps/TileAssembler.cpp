@@ -20,11 +20,15 @@
 #include "MapTree.h"
 #include "BoundingIntervalHierarchy.h"
 #include "VMapDefinitions.h"
+#include "Timer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <set>
 #include <iomanip>
 #include <sstream>
 #include <iomanip>
+#include <thread>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -44,6 +48,32 @@ namespace VMAP
         return memcmp(dest, compare, len) == 0;
     }
 
+    /// Calls task(0) .. task(count - 1) from up to threads threads (the calling one included),
+    /// no new indexes are handed out after a task failed
+    template<class Task>
+    static bool RunTasks(uint32 threads, uint32 count, Task const& task)
+    {
+        std::atomic<uint32> next(0);
+        std::atomic<bool> success(true);
+        auto worker = [&]()
+        {
+            for (uint32 i = next++; i < count && success; i = next++)
+                if (!task(i))
+                    success = false;
+        };
+
+        std::vector<std::thread> workers;
+        for (uint32 i = 1; i < std::min(threads, count); ++i)
+            workers.push_back(std::thread(worker));
+
+        worker();
+
+        for (std::thread& thread : workers)
+            thread.join();
+
+        return success;
+    }
+
     Vector3 ModelPosition::transform(const Vector3& pIn) const
     {
         Vector3 out = pIn * iScale;
@@ -65,145 +95,169 @@ namespace VMAP
         //delete iCoordModelMapping;
     }
 
-    bool TileAssembler::convertWorld2()
+    bool TileAssembler::convertWorld2(uint32 threads)
     {
         bool success = readMapSpawns();
         if (!success)
             return false;
 
-        // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        uint32 startTime = getMSTime();
+
+        // maps don't share any data, every map is written by a single thread
+        std::vector<std::pair<uint32, MapSpawns*>> maps(mapData.begin(), mapData.end());
+        std::vector<std::set<std::string>> mapModelFiles(maps.size());
+        success = RunTasks(threads, maps.size(), [&](uint32 index)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
-            {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                        break;
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    /// @todo remove extractor hack and uncomment below line:
-                    //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
-            }
+            return convertMap(maps[index].first, *maps[index].second, mapModelFiles[index]);
+        });
 
-            printf("Creating map tree for map %u...\n", map_iter->first);
-            BIH pTree;
+        for (std::set<std::string> const& modelFiles : mapModelFiles)
+            spawnedModelFiles.insert(modelFiles.begin(), modelFiles.end());
 
-            try
-            {
-                pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
-            }
-            catch (std::exception& e)
+        printf("Map trees written in %u ms\n", GetMSTimeDiffToNow(startTime));
+
+        // add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels();
+        // export objects
+        std::cout << "\nConverting Model Files" << std::endl;
+        startTime = getMSTime();
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        if (!RunTasks(threads, modelFiles.size(), [&](uint32 index)
+        {
+            // printf keeps lines of different threads apart
+            printf("Converting %s\n", modelFiles[index].c_str());
+            if (!convertRawFile(modelFiles[index]))
             {
-                printf("Exception ""%s"" when calling pTree.build", e.what());
+                printf("error converting %s\n", modelFiles[index].c_str());
                 return false;
             }
+            return true;
+        }))
+            success = false;
+
+        printf("%u model files converted in %u ms\n", uint32(modelFiles.size()), GetMSTimeDiffToNow(startTime));
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i=0; i<mapSpawns.size(); ++i)
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+        //cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        return success;
+    }
+
+    bool TileAssembler::convertMap(uint32 mapID, MapSpawns& spawns, std::set<std::string>& modelFiles)
+    {
+        uint32 startTime = getMSTime();
+        bool success = true;
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(4) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        printf("Calculating model bounds for map %u...\n", mapID);
+        for (entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
+                if (!calculateTransformedBound(entry->second))
+                    break;
             }
-
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-            for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                /// @todo remove extractor hack and uncomment below line:
+                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f*32, 533.33333f*32, 0.f);
             }
+            mapSpawns.push_back(&(entry->second));
+            modelFiles.insert(entry->second.name);
+        }
 
-            fclose(mapfile);
+        printf("Creating map tree for map %u...\n", mapID);
+        BIH pTree;
+
+        try
+        {
+            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        }
+        catch (std::exception& e)
+        {
+            printf("Exception ""%s"" when calling pTree.build", e.what());
+            return false;
+        }
 
-            // <====
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i=0; i<mapSpawns.size(); ++i)
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap &tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
-            {
-                const ModelSpawn &spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
-                    continue;
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << '/' << std::setw(4) << map_iter->first << '_';
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
-                if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
-                {
-                    // file header
-                    if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
-                    // write number of tile spawns
-                    if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-                    // write tile spawns
-                    for (uint32 s=0; s<nSpawns; ++s)
-                    {
-                        if (s)
-                            ++tile;
-                        const ModelSpawn &spawn2 = map_iter->second->UniqueEntries[tile->second];
-                        success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                        // MapTree nodes to update when loading tile:
-                        std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                        if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-                    }
-                    fclose(tilefile);
-                }
-            }
-            // break; //test, extract only first map; TODO: remvoe this line
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(4) << mapID << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
         }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns.TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+        for (TileMap::iterator glob=globalRange.first; glob != globalRange.second && success; ++glob)
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
-            {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
-            }
+            success = ModelSpawn::writeToFile(mapfile, spawns.UniqueEntries[glob->second]);
         }
 
-        //cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        fclose(mapfile);
+
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap &tileEntries = spawns.TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
         {
-            delete map_iter->second;
+            const ModelSpawn &spawn = spawns.UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+                continue;
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << '/' << std::setw(4) << mapID << '_';
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
+            if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
+            {
+                // file header
+                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
+                // write number of tile spawns
+                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+                // write tile spawns
+                for (uint32 s=0; s<nSpawns; ++s)
+                {
+                    if (s)
+                        ++tile;
+                    const ModelSpawn &spawn2 = spawns.UniqueEntries[tile->second];
+                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                    // MapTree nodes to update when loading tile:
+                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
+                }
+                fclose(tilefile);
+            }
         }
+
+        printf("Map %u written in %u ms\n", mapID, GetMSTimeDiffToNow(startTime));
         return success;
     }
 
@@ -276,7 +330,7 @@ namespace VMAP
 
             if (vertices.empty())
             {
-                std::cout << "error: model '" << spawn.name << "' has no geometry!" << std::endl;
+                printf("error: model '%s' has no geometry!\n", spawn.name.c_str());
                 continue;
             }
 
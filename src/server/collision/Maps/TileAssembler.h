@@ -101,11 +101,14 @@ namespace VMAP
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
 
+            bool convertMap(uint32 mapID, MapSpawns& spawns, std::set<std::string>& modelFiles);
+
         public:
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
             virtual ~TileAssembler();
 
-            bool convertWorld2();
+            /// Maps and model files are converted on up to threads threads, output does not depend on the thread count
+            bool convertWorld2(uint32 threads = 1);
             bool readMapSpawns();
             bool calculateTransformedBound(ModelSpawn &spawn);
             void exportGameobjectModels();
@@ -53,6 +53,7 @@ SmartScript::SmartScript()
     mTemplate = SMARTAI_TEMPLATE_BASIC;
     mScriptType = SMART_SCRIPT_TYPE_CREATURE;
     isProcessingTimedActionList = false;
+    memset(mEventIndexOffsets, 0, sizeof(mEventIndexOffsets));
 }
 
 SmartScript::~SmartScript()
@@ -83,21 +84,50 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_END)//special handling
+        return;
+
+    for (uint32 i = mEventIndexOffsets[e]; i < mEventIndexOffsets[e + 1]; ++i)
     {
-        SMART_EVENT eventType = SMART_EVENT(i->GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+        SmartScriptHolder& holder = mEvents[mEventIndex[i]];
+        if (IsConditionMet(holder, unit))
+            ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
+    }
+}
 
-        if (eventType == e /*&& (!i->event.event_phase_mask || IsInPhase(i->event.event_phase_mask)) && !(i->event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE && i->runOnce)*/)
-        {
-            ConditionList conds = sConditionMgr->GetConditionsForSmartEvent(i->entryOrGuid, i->event_id, i->source_type);
-            ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject());
+bool SmartScript::IsConditionMet(SmartScriptHolder& e, Unit* unit)
+{
+    // conditions are resolved when the script is loaded, again only after they were reloaded
+    if (e.conditions.LoadCount != sConditionMgr->GetLoadCount())
+        sConditionMgr->CompileConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type, e.conditions);
 
-            if (sConditionMgr->IsObjectMeetToConditions(info, conds))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-        }
-    }
+    if (e.conditions.Conditions.empty())
+        return true;
+
+    ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject());
+    return sConditionMgr->IsObjectMeetToConditions(info, e.conditions.Conditions);
+}
+
+void SmartScript::BuildEventIndex()
+{
+    ASSERT(mEvents.size() < 0xFFFF);
+
+    // counting sort of event positions by type
+    memset(mEventIndexOffsets, 0, sizeof(mEventIndexOffsets));
+    for (SmartScriptHolder const& holder : mEvents)
+        if (holder.GetEventType() < SMART_EVENT_END)
+            ++mEventIndexOffsets[holder.GetEventType() + 1];
+
+    for (uint32 i = 1; i <= SMART_EVENT_END; ++i)
+        mEventIndexOffsets[i] += mEventIndexOffsets[i - 1];
+
+    uint16 next[SMART_EVENT_END];
+    memcpy(next, mEventIndexOffsets, sizeof(next));
+
+    mEventIndex.resize(mEventIndexOffsets[SMART_EVENT_END]);
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+        if (mEvents[i].GetEventType() < SMART_EVENT_END)
+            mEventIndex[next[mEvents[i].GetEventType()]++] = uint16(i);
 }
 
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
@@ -2333,10 +2363,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
 void SmartScript::ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit, uint32 var0, uint32 var1, bool bvar, const SpellInfo* spell, GameObject* gob)
 {
-    ConditionList const conds = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
-    ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject());
-
-    if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+    if (IsConditionMet(e, unit))
         ProcessAction(e, unit, var0, var1, bvar, spell, gob);
 
     RecalcTimer(e, min, max);
@@ -3396,6 +3423,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        BuildEventIndex();
     }
 }
 
@@ -3483,6 +3511,8 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+    BuildEventIndex();
+
     if (mEvents.empty() && obj)
         TC_LOG_ERROR("sql.sql", "SmartScript: Entry %u has events but no events added to list because of instance flags.", obj->GetEntry());
     if (mEvents.empty() && at)
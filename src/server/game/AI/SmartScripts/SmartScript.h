@@ -258,7 +258,12 @@ class SmartScript
         bool IsInPhase(uint32 p) const { return ((1 << (mEventPhase - 1)) & p) != 0; }
         void SetPhase(uint32 p = 0) { mEventPhase = p; }
 
+        bool IsConditionMet(SmartScriptHolder& e, Unit* unit);
+        void BuildEventIndex();
+
         SmartAIEventList mEvents;
+        std::vector<uint16> mEventIndex;                    // positions in mEvents grouped by event type, script order kept inside each type
+        uint16 mEventIndexOffsets[SMART_EVENT_END + 1];     // first position in mEventIndex for each event type
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         bool isProcessingTimedActionList;
@@ -257,6 +257,9 @@ void SmartAIMgr::LoadSmartAIFromDB()
             SmartAIEventList eventList;
             mEventMap[source_type][temp.entryOrGuid] = eventList;
         }
+        // resolve conditions once here, script instances copy them along with the event
+        sConditionMgr->CompileConditionsForSmartEvent(temp.entryOrGuid, temp.event_id, temp.source_type, temp.conditions);
+
         // store the new event
         mEventMap[source_type][temp.entryOrGuid].push_back(temp);
     }
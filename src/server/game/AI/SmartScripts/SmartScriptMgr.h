@@ -19,6 +19,7 @@
 #define TRINITY_SMARTSCRIPTMGR_H
 
 #include "Common.h"
+#include "ConditionMgr.h"
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "Unit.h"
@@ -1364,6 +1365,8 @@ struct SmartScriptHolder
     SmartAction action;
     SmartTarget target;
 
+    CompiledConditionList conditions;
+
     uint32 GetScriptType() const { return (uint32)source_type; }
     uint32 GetEventType() const { return (uint32)event.type; }
     uint32 GetActionType() const { return (uint32)action.type; }
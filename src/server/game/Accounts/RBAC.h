@@ -739,6 +739,11 @@ enum RBACPermissions
     RBAC_PERM_COMMAND_TICKET_RESET_COMPLAINT                 = 832,
     RBAC_PERM_COMMAND_TICKET_RESET_SUGGESTION                = 833,
     RBAC_PERM_COMMAND_GO_QUEST                               = 834,
+    RBAC_PERM_COMMAND_DEBUG_AURAUPDATES                      = 835,
+    RBAC_PERM_COMMAND_DEBUG_PROCSTATS                        = 836,
+    RBAC_PERM_COMMAND_DEBUG_PACKETSTATS                      = 837,
+    RBAC_PERM_COMMAND_DEBUG_CHARCACHE                        = 838,
+    RBAC_PERM_COMMAND_DEBUG_ACHIEVEMENTSTATS                 = 839,
 
     // custom permissions 1000+
     RBAC_PERM_MAX
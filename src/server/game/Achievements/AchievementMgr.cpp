@@ -43,6 +43,52 @@
 #include "SpellMgr.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <limits>
+
+enum CriteriaAssetMatch
+{
+    CRITERIA_ASSET_MATCH_NONE,      // miscValue1 is not compared with the criteria asset
+    CRITERIA_ASSET_MATCH_REQUIRED,  // miscValue1 must be set and equal to the asset
+    CRITERIA_ASSET_MATCH_OPTIONAL   // miscValue1 equal to the asset, 0 updates all criteria of the type (login)
+};
+
+// Must stay in sync with the asset checks in AchievementMgr<T>::RequirementsSatisfied
+static CriteriaAssetMatch GetCriteriaAssetMatch(AchievementCriteriaTypes type)
+{
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_CLASS:
+        case ACHIEVEMENT_CRITERIA_TYPE_HK_RACE:
+        case ACHIEVEMENT_CRITERIA_TYPE_BG_OBJECTIVE_CAPTURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_HONORABLE_KILL_AT_AREA:
+        case ACHIEVEMENT_CRITERIA_TYPE_CURRENCY:
+            return CRITERIA_ASSET_MATCH_REQUIRED;
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILLLINE_SPELLS:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LINE:
+            return CRITERIA_ASSET_MATCH_OPTIONAL;
+        default:
+            return CRITERIA_ASSET_MATCH_NONE;
+    }
+}
 
 bool AchievementCriteriaData::IsValid(AchievementCriteria const* criteria)
 {
@@ -652,6 +698,7 @@ void AchievementMgr<Player>::LoadFromDB(PreparedQueryResult achievementResult, P
             ca.changed = false;
 
             _achievementPoints += achievement->Points;
+            AddCompletedCriteriaTree(achievement);
 
             // title achievement rewards are retroactive
             if (AchievementReward const* reward = sAchievementMgr->GetAchievementReward(achievement))
@@ -722,6 +769,7 @@ void AchievementMgr<Guild>::LoadFromDB(PreparedQueryResult achievementResult, Pr
             ca.changed = false;
 
             _achievementPoints += achievement->Points;
+            AddCompletedCriteriaTree(achievement);
         }
         while (achievementResult->NextRow());
     }
@@ -784,6 +832,7 @@ void AchievementMgr<Player>::Reset()
     }
 
     m_completedAchievements.clear();
+    _completedCriteria.clear();
     _achievementPoints = 0;
     m_criteriaProgress.clear();
     DeleteFromDB(GetOwner()->GetGUID());
@@ -811,6 +860,7 @@ void AchievementMgr<Guild>::Reset()
 
     _achievementPoints = 0;
     m_completedAchievements.clear();
+    _completedCriteria.clear();
     DeleteFromDB(GetOwner()->GetGUID());
 }
 
@@ -903,21 +953,58 @@ void AchievementMgr<Player>::SendCriteriaUpdate(AchievementCriteria const* crite
 }
 
 template<>
-void AchievementMgr<Guild>::SendCriteriaUpdate(AchievementCriteria const* entry, CriteriaProgress const* progress, uint32 /*timeElapsed*/, bool /*timedCompleted*/) const
+void AchievementMgr<Guild>::SendCriteriaUpdate(AchievementCriteria const* entry, CriteriaProgress const* /*progress*/, uint32 /*timeElapsed*/, bool /*timedCompleted*/) const
 {
-    WorldPackets::Achievement::GuildCriteriaUpdate guildCriteriaUpdate;
-    guildCriteriaUpdate.Progress.resize(1);
+    // a single kill or deposit can update many criteria of a big guild, send them all at once after the map updates
+    // members can be on different maps, so this runs concurrently from several map threads
+    bool schedule;
+    {
+        std::lock_guard<std::mutex> lock(_pendingCriteriaUpdatesLock);
+        schedule = _pendingCriteriaUpdates.empty();
+        _pendingCriteriaUpdates.insert(entry->ID);
+    }
 
-    WorldPackets::Achievement::GuildCriteriaProgress& guildCriteriaProgress = guildCriteriaUpdate.Progress[0];
-    guildCriteriaProgress.CriteriaID = entry->ID;
-    guildCriteriaProgress.DateCreated = 0;
-    guildCriteriaProgress.DateStarted = 0;
-    guildCriteriaProgress.DateUpdated = progress->date;
-    guildCriteriaProgress.Quantity = progress->counter;
-    guildCriteriaProgress.PlayerGUID = progress->PlayerGUID;
-    guildCriteriaProgress.Flags = 0;
+    if (schedule)
+        sGuildMgr->ScheduleCriteriaUpdates(GetOwner()->GetId());
+}
 
-    GetOwner()->BroadcastPacketIfTrackingAchievement(guildCriteriaUpdate.Write(), entry->ID);
+template<class T>
+void AchievementMgr<T>::SendPendingCriteriaUpdates()
+{
+}
+
+template<>
+void AchievementMgr<Guild>::SendPendingCriteriaUpdates()
+{
+    std::set<uint32> criteriaIds;
+    {
+        std::lock_guard<std::mutex> lock(_pendingCriteriaUpdatesLock);
+        criteriaIds.swap(_pendingCriteriaUpdates);
+    }
+
+    std::vector<WorldPackets::Achievement::GuildCriteriaProgress> progress;
+    progress.reserve(criteriaIds.size());
+
+    for (uint32 criteriaId : criteriaIds)
+    {
+        // progress removed in the meantime
+        CriteriaProgressMap::const_iterator itr = m_criteriaProgress.find(criteriaId);
+        if (itr == m_criteriaProgress.end())
+            continue;
+
+        WorldPackets::Achievement::GuildCriteriaProgress guildCriteriaProgress;
+        guildCriteriaProgress.CriteriaID = criteriaId;
+        guildCriteriaProgress.DateCreated = 0;
+        guildCriteriaProgress.DateStarted = 0;
+        guildCriteriaProgress.DateUpdated = itr->second.date;
+        guildCriteriaProgress.Quantity = itr->second.counter;
+        guildCriteriaProgress.PlayerGUID = itr->second.PlayerGUID;
+        guildCriteriaProgress.Flags = 0;
+        progress.push_back(guildCriteriaProgress);
+    }
+
+    if (!progress.empty())
+        GetOwner()->BroadcastCriteriaProgress(progress);
 }
 
 template<class T>
@@ -1000,9 +1087,19 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes type,
     //if (IsGuild<T>() && !sWorld->getBoolConfig(CONFIG_GUILD_LEVELING_ENABLED))
     //    return;
 
-    AchievementCriteriaList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type, IsGuild<T>());
+    AchievementCriteriaList const& achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByTypeAndAsset(type, miscValue1, IsGuild<T>());
+    uint64 evaluated = 0;
+    uint64 skippedCompleted = 0;
     for (AchievementCriteria const* achievementCriteria : achievementCriteriaList)
     {
+        // every achievement using this criteria is already earned
+        if (_completedCriteria.count(achievementCriteria->ID))
+        {
+            ++skippedCompleted;
+            continue;
+        }
+
+        ++evaluated;
         AchievementCriteriaTreeList const* trees = sAchievementMgr->GetAchievementCriteriaTreesByCriteria(achievementCriteria->ID);
 
         if (!CanUpdateCriteria(achievementCriteria, trees, miscValue1, miscValue2, miscValue3, unit, referencePlayer))
@@ -1289,6 +1386,8 @@ void AchievementMgr<T>::UpdateAchievementCriteria(AchievementCriteriaTypes type,
                         CompletedAchievement(refAchievement, referencePlayer);
         }
     }
+
+    sAchievementMgr->RecordCriteriaUpdate(evaluated, sAchievementMgr->GetAchievementCriteriaByType(type, IsGuild<T>()).size() - achievementCriteriaList.size(), skippedCompleted);
 }
 
 // Only player personal achievements require instance id to check realm firsts
@@ -1504,6 +1603,31 @@ bool AchievementMgr<T>::IsCompletedAchievement(AchievementEntry const* entry)
     return IsCompletedCriteriaTree(tree);
 }
 
+template<class T>
+void AchievementMgr<T>::AddCompletedCriteriaTree(AchievementEntry const* achievement)
+{
+    AchievementCriteriaTree const* tree = sAchievementMgr->GetAchievementCriteriaTree(achievement->CriteriaTree);
+    if (!tree)
+        return;
+
+    // criteria shared with achievements not earned yet must keep updating
+    sAchievementMgr->WalkCriteriaTree(tree, [this](AchievementCriteriaTree const* node)
+    {
+        if (!node->Criteria)
+            return;
+
+        AchievementCriteriaTreeList const* trees = sAchievementMgr->GetAchievementCriteriaTreesByCriteria(node->Criteria->ID);
+        if (!trees)
+            return;
+
+        for (AchievementCriteriaTree const* criteriaTree : *trees)
+            if (!this->HasAchieved(criteriaTree->Achievement->ID))
+                return;
+
+        _completedCriteria.insert(node->Criteria->ID);
+    });
+}
+
 template<class T>
 CriteriaProgress* AchievementMgr<T>::GetCriteriaProgress(AchievementCriteria const* entry)
 {
@@ -1719,6 +1843,7 @@ void AchievementMgr<Player>::CompletedAchievement(AchievementEntry const* achiev
     sAchievementMgr->SetRealmCompleted(achievement, GetOwner()->GetInstanceId());
 
     _achievementPoints += achievement->Points;
+    AddCompletedCriteriaTree(achievement);
 
     UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT, 0, 0, 0, NULL, referencePlayer);
     UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_EARN_ACHIEVEMENT_POINTS, achievement->Points, 0, 0, NULL, referencePlayer);
@@ -1812,6 +1937,7 @@ void AchievementMgr<Guild>::CompletedAchievement(AchievementEntry const* achieve
     sAchievementMgr->SetRealmCompleted(achievement, referencePlayer->GetInstanceId());
 
     _achievementPoints += achievement->Points;
+    AddCompletedCriteriaTree(achievement);
 
     UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_ACHIEVEMENT, 0, 0, 0, NULL, referencePlayer);
     UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_EARN_ACHIEVEMENT_POINTS, achievement->Points, 0, 0, NULL, referencePlayer);
@@ -2885,12 +3011,16 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
         {
             ++guildCriterias;
             _guildAchievementCriteriasByType[criteria->Type].push_back(achievementCriteria);
+            if (GetCriteriaAssetMatch(AchievementCriteriaTypes(criteria->Type)) != CRITERIA_ASSET_MATCH_NONE)
+                _guildAchievementCriteriasByAsset[criteria->Type][criteria->Asset.ID].push_back(achievementCriteria);
         }
 
         if (achievementCriteria->FlagsCu & (ACHIEVEMENT_CRITERIA_FLAG_CU_PLAYER | ACHIEVEMENT_CRITERIA_FLAG_CU_ACCOUNT))
         {
             ++criterias;
             _achievementCriteriasByType[criteria->Type].push_back(achievementCriteria);
+            if (GetCriteriaAssetMatch(AchievementCriteriaTypes(criteria->Type)) != CRITERIA_ASSET_MATCH_NONE)
+                _achievementCriteriasByAsset[criteria->Type][criteria->Asset.ID].push_back(achievementCriteria);
         }
 
         if (criteria->StartTimer)
@@ -2900,6 +3030,32 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
     TC_LOG_INFO("server.loading", ">> Loaded %u achievement criteria and %u guild achievement crieteria in %u ms", criterias, guildCriterias, GetMSTimeDiffToNow(oldMSTime));
 }
 
+AchievementCriteriaList const& AchievementGlobalMgr::GetAchievementCriteriaByTypeAndAsset(AchievementCriteriaTypes type, uint64 miscValue1, bool guild /*= false*/) const
+{
+    CriteriaAssetMatch match = GetCriteriaAssetMatch(type);
+    if (match == CRITERIA_ASSET_MATCH_NONE || (match == CRITERIA_ASSET_MATCH_OPTIONAL && !miscValue1))
+        return GetAchievementCriteriaByType(type, guild);
+
+    // RequirementsSatisfied rejects these for every criteria of the type
+    if (!miscValue1 || miscValue1 > std::numeric_limits<uint32>::max())
+        return _emptyCriteriaList;
+
+    AchievementCriteriaListByAsset const& byAsset = guild ? _guildAchievementCriteriasByAsset[type] : _achievementCriteriasByAsset[type];
+    auto itr = byAsset.find(uint32(miscValue1));
+    if (itr == byAsset.end())
+        return _emptyCriteriaList;
+
+    return itr->second;
+}
+
+void AchievementGlobalMgr::RecordCriteriaUpdate(uint64 evaluated, uint64 skippedByAsset, uint64 skippedCompleted)
+{
+    ++_criteriaUpdateStatistics.Updates;
+    _criteriaUpdateStatistics.Evaluated += evaluated;
+    _criteriaUpdateStatistics.SkippedByAsset += skippedByAsset;
+    _criteriaUpdateStatistics.SkippedCompleted += skippedCompleted;
+}
+
 void AchievementGlobalMgr::LoadAchievementReferenceList()
 {
     uint32 oldMSTime = getMSTime();
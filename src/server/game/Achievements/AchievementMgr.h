@@ -19,8 +19,12 @@
 #ifndef __TRINITY_ACHIEVEMENTMGR_H
 #define __TRINITY_ACHIEVEMENTMGR_H
 
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <set>
 #include <string>
+#include <unordered_set>
 
 #include "Common.h"
 #include "DatabaseEnv.h"
@@ -284,6 +288,14 @@ enum ProgressType
     PROGRESS_HIGHEST
 };
 
+struct AchievementCriteriaUpdateStatistics
+{
+    std::atomic<uint64> Updates;                            // UpdateAchievementCriteria calls
+    std::atomic<uint64> Evaluated;                          // criteria checked by CanUpdateCriteria
+    std::atomic<uint64> SkippedByAsset;                     // criteria of the updated type not examined thanks to the asset index
+    std::atomic<uint64> SkippedCompleted;                   // criteria skipped because all of their achievements are earned
+};
+
 template<class T>
 class AchievementMgr
 {
@@ -302,6 +314,7 @@ class AchievementMgr
         void SendAllAchievementData(Player* receiver) const;
         void SendAllTrackedCriterias(Player* receiver, std::set<uint32> const& trackedCriterias) const;
         void SendAchievementInfo(Player* receiver, uint32 achievementId = 0) const;
+        void SendPendingCriteriaUpdates();
         bool HasAchieved(uint32 achievementId) const;
         T* GetOwner() const { return _owner; }
 
@@ -320,6 +333,7 @@ class AchievementMgr
         bool IsCompletedCriteriaTree(AchievementCriteriaTree const* tree);
         bool IsCompletedCriteria(AchievementCriteria const* achievementCriteria, uint64 requiredAmount);
         bool IsCompletedAchievement(AchievementEntry const* entry);
+        void AddCompletedCriteriaTree(AchievementEntry const* achievement);
         bool CanUpdateCriteria(AchievementCriteria const* criteria, AchievementCriteriaTreeList const* trees, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, Unit const* unit, Player* referencePlayer);
         void SendPacket(WorldPacket const* data) const;
 
@@ -333,6 +347,9 @@ class AchievementMgr
         typedef std::map<uint32, uint32> TimedAchievementMap;
         TimedAchievementMap m_timedAchievements;      // Criteria tree id/time left in MS
         uint32 _achievementPoints;
+        std::unordered_set<uint32> _completedCriteria;  // criteria of earned achievements only, never updated again
+        mutable std::set<uint32> _pendingCriteriaUpdates; // guild criteria changed since the last world update
+        mutable std::mutex _pendingCriteriaUpdatesLock;
 };
 
 class AchievementGlobalMgr
@@ -361,6 +378,8 @@ class AchievementGlobalMgr
             return guild ? _guildAchievementCriteriasByType[type] : _achievementCriteriasByType[type];
         }
 
+        AchievementCriteriaList const& GetAchievementCriteriaByTypeAndAsset(AchievementCriteriaTypes type, uint64 miscValue1, bool guild = false) const;
+
         AchievementCriteriaList const& GetTimedAchievementCriteriaByType(AchievementCriteriaTimedTypes type) const
         {
             return _achievementCriteriasByTimedType[type];
@@ -437,6 +456,9 @@ class AchievementGlobalMgr
             func(tree);
         }
 
+        AchievementCriteriaUpdateStatistics const& GetCriteriaUpdateStatistics() const { return _criteriaUpdateStatistics; }
+        void RecordCriteriaUpdate(uint64 evaluated, uint64 skippedByAsset, uint64 skippedCompleted);
+
         // Removes instanceId as valid id to complete realm first kill achievements
         void OnInstanceDestroyed(uint32 instanceId);
 
@@ -465,6 +487,14 @@ class AchievementGlobalMgr
 
         AchievementCriteriaList _achievementCriteriasByTimedType[ACHIEVEMENT_TIMED_TYPE_MAX];
 
+        // criteria of types that compare miscValue1 with their asset, by asset
+        typedef std::unordered_map<uint32, AchievementCriteriaList> AchievementCriteriaListByAsset;
+        AchievementCriteriaListByAsset _achievementCriteriasByAsset[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        AchievementCriteriaListByAsset _guildAchievementCriteriasByAsset[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        AchievementCriteriaList _emptyCriteriaList;
+
+        AchievementCriteriaUpdateStatistics _criteriaUpdateStatistics;
+
         // store achievements by referenced achievement id to speed up lookup
         AchievementListByReferencedId _achievementListByReferencedId;
 
@@ -102,13 +102,15 @@ bool ArenaTeam::AddMember(ObjectGuid playerGuid)
         playerClass = player->getClass();
         playerName = player->GetName();
     }
-    else if (CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(playerGuid))
+    else
     {
-        playerName = characterInfo->Name;
-        playerClass = characterInfo->Class;
+        CharacterInfo characterInfo;
+        if (!sWorld->GetCharacterInfo(playerGuid, characterInfo))
+            return false;
+
+        playerName = characterInfo.Name;
+        playerClass = characterInfo.Class;
     }
-    else
-        return false;
 
     // Check if player is already in a similar arena team
     if ((player && player->GetArenaTeamId(GetSlot())) || Player::GetArenaTeamIdFromDB(playerGuid, GetType()) != 0)
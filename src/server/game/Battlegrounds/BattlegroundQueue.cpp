@@ -134,6 +134,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
     // create new ginfo
     GroupQueueInfo* ginfo            = new GroupQueueInfo;
     ginfo->BgTypeId                  = BgTypeId;
+    ginfo->BracketId                 = bracketId;
     ginfo->ArenaType                 = ArenaType;
     ginfo->ArenaTeamId               = arenateamid;
     ginfo->IsRated                   = isRated;
@@ -192,6 +193,8 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
     //add GroupInfo to m_QueuedGroups
     {
         m_QueuedGroups[bracketId][index].push_back(ginfo);
+        if (isRated)
+            m_RatedGroups[bracketId][index].insert(std::make_pair(ginfo->ArenaMatchmakerRating, ginfo));
 
         //announce to world, this code needs mutex
         if (!isRated && !isPremade && sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE))
@@ -283,7 +286,7 @@ uint32 BattlegroundQueue::GetAverageQueueWaitTime(GroupQueueInfo* ginfo, Battleg
 //remove player from queue and from group info, if group info is empty then remove it too
 void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
 {
-    int32 bracket_id = -1;                                     // signed for proper for-loop finish
+    int32 bracket_id = -1;                                     // -1 until the group is found in its bracket
     QueuedPlayersMap::iterator itr;
 
     //remove player from map, if he's there
@@ -299,29 +302,20 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
 
     GroupQueueInfo* group = itr->second.GroupInfo;
     GroupsQueueType::iterator group_itr;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
 
     uint32 index = (group->Team == HORDE) ? BG_QUEUE_PREMADE_HORDE : BG_QUEUE_PREMADE_ALLIANCE;
 
-    for (int32 bracket_id_tmp = MAX_BATTLEGROUND_BRACKETS - 1; bracket_id_tmp >= 0 && bracket_id == -1; --bracket_id_tmp)
+    //we must check premade and normal team's queue - because when players from premade are joining bg,
+    //they leave groupinfo so we can't use its players size to find out index
+    for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT && bracket_id == -1; j += BG_TEAMS_COUNT)
     {
-        //we must check premade and normal team's queue - because when players from premade are joining bg,
-        //they leave groupinfo so we can't use its players size to find out index
-        for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_TEAMS_COUNT)
+        GroupsQueueType::iterator k = std::find(m_QueuedGroups[group->BracketId][j].begin(), m_QueuedGroups[group->BracketId][j].end(), group);
+        if (k != m_QueuedGroups[group->BracketId][j].end())
         {
-            GroupsQueueType::iterator k = m_QueuedGroups[bracket_id_tmp][j].begin();
-            for (; k != m_QueuedGroups[bracket_id_tmp][j].end(); ++k)
-            {
-                if ((*k) == group)
-                {
-                    bracket_id = bracket_id_tmp;
-                    group_itr = k;
-                    //we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
+            bracket_id = group->BracketId;
+            group_itr = k;
+            //we must store index to be able to erase iterator
+            index = j;
         }
     }
 
@@ -374,6 +368,8 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     if (group->Players.empty())
     {
         m_QueuedGroups[bracket_id][index].erase(group_itr);
+        if (group->IsRated)
+            RemoveRatedGroup(group, index);
         delete group;
         return;
     }
@@ -425,6 +421,43 @@ uint32 BattlegroundQueue::GetPlayersInQueue(TeamId id)
     return m_SelectionPools[id].GetPlayerCount();
 }
 
+// returns the rated arena team that waits longest in queue index and is either inside the rating window or waits longer than the rating discard time
+GroupQueueInfo* BattlegroundQueue::FindRatedArenaTeam(BattlegroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, uint32 excludedArenaTeamId) const
+{
+    // teams not invited yet are ordered by join time, so the ones past the discard time are all in front
+    for (GroupsQueueType::const_iterator itr = m_QueuedGroups[bracket_id][index].begin(); itr != m_QueuedGroups[bracket_id][index].end(); ++itr)
+    {
+        if ((*itr)->IsInvitedToBGInstanceGUID || (*itr)->ArenaTeamId == excludedArenaTeamId)
+            continue;
+
+        if ((*itr)->JoinTime < discardTime)
+            return *itr;
+        break;
+    }
+
+    GroupQueueInfo* ginfo = NULL;
+    RatedGroupsQueueType const& ratedGroups = m_RatedGroups[bracket_id][index];
+    for (RatedGroupsQueueType::const_iterator itr = ratedGroups.lower_bound(minRating); itr != ratedGroups.end() && itr->first <= maxRating; ++itr)
+        if (!itr->second->IsInvitedToBGInstanceGUID && itr->second->ArenaTeamId != excludedArenaTeamId && (!ginfo || itr->second->JoinTime < ginfo->JoinTime))
+            ginfo = itr->second;
+
+    return ginfo;
+}
+
+void BattlegroundQueue::RemoveRatedGroup(GroupQueueInfo* ginfo, uint32 index)
+{
+    RatedGroupsQueueType& ratedGroups = m_RatedGroups[ginfo->BracketId][index];
+    std::pair<RatedGroupsQueueType::iterator, RatedGroupsQueueType::iterator> bounds = ratedGroups.equal_range(ginfo->ArenaMatchmakerRating);
+    for (RatedGroupsQueueType::iterator itr = bounds.first; itr != bounds.second; ++itr)
+    {
+        if (itr->second == ginfo)
+        {
+            ratedGroups.erase(itr);
+            break;
+        }
+    }
+}
+
 bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side)
 {
     // set side if needed
@@ -893,25 +926,17 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
         uint32 discardTime = getMSTime() - sBattlegroundMgr->GetRatingDiscardTimer();
 
         // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[BG_TEAMS_COUNT];
+        GroupQueueInfo* teams[BG_TEAMS_COUNT];
         uint8 found = 0;
         uint8 team = 0;
 
         for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
         {
-            // take the group that joined first
-            GroupsQueueType::iterator itr2 = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr2 != m_QueuedGroups[bracket_id][i].end(); ++itr2)
+            // take the group that joined first, rated arena teams always have an id
+            if (GroupQueueInfo* ginfo = FindRatedArenaTeam(bracket_id, i, arenaMinRating, arenaMaxRating, discardTime, 0))
             {
-                // if group match conditions, then add it to pool
-                if (!(*itr2)->IsInvitedToBGInstanceGUID
-                    && (((*itr2)->ArenaMatchmakerRating >= arenaMinRating && (*itr2)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (*itr2)->JoinTime < discardTime))
-                {
-                    itr_teams[found++] = itr2;
-                    team = i;
-                    break;
-                }
+                teams[found++] = ginfo;
+                team = i;
             }
         }
 
@@ -919,25 +944,14 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
             return;
 
         if (found == 1)
-        {
-            for (GroupsQueueType::iterator itr3 = itr_teams[0]; itr3 != m_QueuedGroups[bracket_id][team].end(); ++itr3)
-            {
-                if (!(*itr3)->IsInvitedToBGInstanceGUID
-                    && (((*itr3)->ArenaMatchmakerRating >= arenaMinRating && (*itr3)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (*itr3)->JoinTime < discardTime)
-                    && (*itr_teams[0])->ArenaTeamId != (*itr3)->ArenaTeamId)
-                {
-                    itr_teams[found++] = itr3;
-                    break;
-                }
-            }
-        }
+            if (GroupQueueInfo* ginfo = FindRatedArenaTeam(bracket_id, team, arenaMinRating, arenaMaxRating, discardTime, teams[0]->ArenaTeamId))
+                teams[found++] = ginfo;
 
         //if we have 2 teams, then start new arena and invite players!
         if (found == 2)
         {
-            GroupQueueInfo* aTeam = *itr_teams[TEAM_ALLIANCE];
-            GroupQueueInfo* hTeam = *itr_teams[TEAM_HORDE];
+            GroupQueueInfo* aTeam = teams[TEAM_ALLIANCE];
+            GroupQueueInfo* hTeam = teams[TEAM_HORDE];
             Battleground* arena = sBattlegroundMgr->CreateNewBattleground(bgTypeId, bracketEntry, arenaType, true);
             if (!arena)
             {
@@ -956,12 +970,16 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
             if (aTeam->Team != ALLIANCE)
             {
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
+                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].remove(aTeam);
+                RemoveRatedGroup(aTeam, BG_QUEUE_PREMADE_HORDE);
+                m_RatedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].insert(std::make_pair(aTeam->ArenaMatchmakerRating, aTeam));
             }
             if (hTeam->Team != HORDE)
             {
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
+                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].remove(hTeam);
+                RemoveRatedGroup(hTeam, BG_QUEUE_PREMADE_ALLIANCE);
+                m_RatedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].insert(std::make_pair(hTeam->ArenaMatchmakerRating, hTeam));
             }
 
             arena->SetArenaMatchmakerRating(ALLIANCE, aTeam->ArenaMatchmakerRating);
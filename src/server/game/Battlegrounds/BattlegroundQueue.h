@@ -43,6 +43,7 @@ struct GroupQueueInfo                                       // stores informatio
     std::map<ObjectGuid, PlayerQueueInfo*> Players;         // player queue info map
     uint32  Team;                                           // Player team (ALLIANCE/HORDE)
     BattlegroundTypeId BgTypeId;                            // battleground type id
+    BattlegroundBracketId BracketId;                        // bracket the group is queued in
     bool    IsRated;                                        // rated
     uint8   ArenaType;                                      // 2v2, 3v3, 5v5 or 0 when BG
     uint32  ArenaTeamId;                                    // team id if rated match
@@ -102,6 +103,10 @@ class BattlegroundQueue
         */
         GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        // rated arena teams of BG_QUEUE_PREMADE_ALLIANCE and BG_QUEUE_PREMADE_HORDE ordered by matchmaker rating
+        typedef std::multimap<uint32, GroupQueueInfo*> RatedGroupsQueueType;
+        RatedGroupsQueueType m_RatedGroups[MAX_BATTLEGROUND_BRACKETS][BG_TEAMS_COUNT];
+
         // class to select and invite groups to bg
         class SelectionPool
         {
@@ -123,6 +128,8 @@ class BattlegroundQueue
     private:
 
         bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side);
+        GroupQueueInfo* FindRatedArenaTeam(BattlegroundBracketId bracket_id, uint32 index, uint32 minRating, uint32 maxRating, uint32 discardTime, uint32 excludedArenaTeamId) const;
+        void RemoveRatedGroup(GroupQueueInfo* ginfo, uint32 index);
         uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
         uint32 m_WaitTimeLastPlayer[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
         uint32 m_SumOfWaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
@@ -26,6 +26,7 @@
 #include "UnitEvents.h"
 #include "SpellAuras.h"
 #include "SpellMgr.h"
+#include <algorithm>
 
 //==============================================================
 //================= ThreatCalcHelper ===========================
@@ -260,6 +261,27 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iThreatIndex.clear();
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    StorageType::iterator itr = std::find(iThreatList.begin(), iThreatList.end(), hostileRef);
+    if (itr == iThreatList.end())
+        return;
+
+    iThreatList.erase(itr);
+    iThreatIndex.erase(hostileRef->getUnitGuid());
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    iThreatList.push_back(hostileRef);
+    iThreatIndex[hostileRef->getUnitGuid()] = hostileRef;
 }
 
 //============================================================
@@ -269,15 +291,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim) const
     if (!victim)
         return NULL;
 
-    ObjectGuid guid = victim->GetGUID();
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-            return ref;
-    }
-
-    return NULL;
+    auto itr = iThreatIndex.find(victim->GetGUID());
+    return itr != iThreatIndex.end() ? itr->second : NULL;
 }
 
 //============================================================
@@ -305,7 +320,19 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Trinity::ThreatOrderPred());
+    {
+        // stable binary insertion sort - references still in order are passed with a single compare,
+        // moved ones are placed after the references with equal threat, same as a stable sort would
+        Trinity::ThreatOrderPred pred;
+        for (StorageType::iterator itr = iThreatList.begin() + 1; itr != iThreatList.end(); ++itr)
+        {
+            if (!pred(*itr, *(itr - 1)))
+                continue;
+
+            StorageType::iterator pos = std::upper_bound(iThreatList.begin(), itr, *itr, pred);
+            std::rotate(pos, itr, itr + 1);
+        }
+    }
 
     iDirty = false;
 }
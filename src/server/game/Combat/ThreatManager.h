@@ -25,7 +25,8 @@
 #include "UnitEvents.h"
 #include "ObjectGuid.h"
 
-#include <list>
+#include <unordered_map>
+#include <vector>
 
 //==============================================================
 
@@ -141,12 +142,14 @@ class HostileReference : public Reference<Unit, ThreatManager>
 //==============================================================
 class ThreatManager;
 
+// References ordered by threat (highest first) in a flat vector, re-ordered in update() after threat changes.
+// Changes between two updates move only few references, so update() places just those with a binary search.
 class ThreatContainer
 {
         friend class ThreatManager;
 
     public:
-        typedef std::list<HostileReference*> StorageType;
+        typedef std::vector<HostileReference*> StorageType;
 
         ThreatContainer(): iDirty(false) { }
 
@@ -177,15 +180,9 @@ class ThreatContainer
         StorageType const & getThreatList() const { return iThreatList; }
 
     private:
-        void remove(HostileReference* hostileRef)
-        {
-            iThreatList.remove(hostileRef);
-        }
+        void remove(HostileReference* hostileRef);
 
-        void addReference(HostileReference* hostileRef)
-        {
-            iThreatList.push_back(hostileRef);
-        }
+        void addReference(HostileReference* hostileRef);
 
         void clearReferences();
 
@@ -193,6 +190,7 @@ class ThreatContainer
         void update();
 
         StorageType iThreatList;
+        std::unordered_map<ObjectGuid, HostileReference*> iThreatIndex;   // by target guid, for threat changes of a given victim
         bool iDirty;
 };
 
@@ -662,29 +662,26 @@ std::string Condition::ToString(bool ext /*= false*/) const
     return ss.str();
 }
 
-ConditionMgr::ConditionMgr() { }
+ConditionMgr::ConditionMgr() : _loadCount(0) { }
 
 ConditionMgr::~ConditionMgr()
 {
     Clean();
 }
 
-ConditionList ConditionMgr::GetConditionReferences(uint32 refId)
+ConditionSpan ConditionMgr::GetConditionReferences(uint32 refId) const
 {
-    ConditionList conditions;
-    ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(refId);
-    if (ref != ConditionReferenceStore.end())
-        conditions = (*ref).second;
-    return conditions;
+    return FindConditions(CONDITION_SOURCE_TYPE_NONE, 0, int32(refId), 0);
 }
 
-uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& conditions)
+template<class Conditions>
+static uint32 GetSearcherTypeMaskForConditions(Conditions const& conditions)
 {
     if (conditions.empty())
         return GRID_MAP_TYPE_MASK_ALL;
     //     groupId, typeMask
     std::map<uint32, uint32> ElseGroupStore;
-    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+    for (typename Conditions::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
     {
         // no point of having not loaded conditions in list
         ASSERT((*i)->isLoaded() && "ConditionMgr::GetSearcherTypeMaskForConditionList - not yet loaded condition found in list");
@@ -698,9 +695,9 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& co
 
         if ((*i)->ReferenceId) // handle reference
         {
-            ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
-            ASSERT(ref != ConditionReferenceStore.end() && "ConditionMgr::GetSearcherTypeMaskForConditionList - incorrect reference");
-            ElseGroupStore[(*i)->ElseGroup] &= GetSearcherTypeMaskForConditionList((*ref).second);
+            ConditionSpan ref = sConditionMgr->GetConditionReferences((*i)->ReferenceId);
+            ASSERT(!ref.empty() && "ConditionMgr::GetSearcherTypeMaskForConditionList - incorrect reference");
+            ElseGroupStore[(*i)->ElseGroup] &= GetSearcherTypeMaskForConditions(ref);
         }
         else // handle normal condition
         {
@@ -718,6 +715,11 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& co
     return mask;
 }
 
+uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& conditions)
+{
+    return GetSearcherTypeMaskForConditions(conditions);
+}
+
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions)
 {
     //     groupId, groupCheckPassed
@@ -737,10 +739,10 @@ bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo,
 
             if ((*i)->ReferenceId)//handle reference
             {
-                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
-                if (ref != ConditionReferenceStore.end())
+                ConditionSpan ref = GetConditionReferences((*i)->ReferenceId);
+                if (!ref.empty())
                 {
-                    if (!IsObjectMeetToConditionList(sourceInfo, (*ref).second))
+                    if (!IsObjectMeetToConditionSpan(sourceInfo, ref))
                         ElseGroupStore[(*i)->ElseGroup] = false;
                 }
                 else
@@ -785,6 +787,62 @@ bool ConditionMgr::IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, Con
     return IsObjectMeetToConditionList(sourceInfo, conditions);
 }
 
+bool ConditionMgr::IsObjectMeetToConditions(WorldObject* object, ConditionSpan conditions)
+{
+    ConditionSourceInfo srcInfo = ConditionSourceInfo(object);
+    return IsObjectMeetToConditions(srcInfo, conditions);
+}
+
+bool ConditionMgr::IsObjectMeetToConditions(WorldObject* object1, WorldObject* object2, ConditionSpan conditions)
+{
+    ConditionSourceInfo srcInfo = ConditionSourceInfo(object1, object2);
+    return IsObjectMeetToConditions(srcInfo, conditions);
+}
+
+bool ConditionMgr::IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, ConditionSpan conditions)
+{
+    if (conditions.empty())
+        return true;
+
+    return IsObjectMeetToConditionSpan(sourceInfo, conditions);
+}
+
+bool ConditionMgr::IsObjectMeetToConditionSpan(ConditionSourceInfo& sourceInfo, ConditionSpan conditions)
+{
+    // indexed conditions are sorted by ElseGroup, met as soon as all conditions of one group are met
+    // not loaded conditions are skipped, a group made only of them is never met (same as IsObjectMeetToConditionList)
+    ConditionSpan::const_iterator i = conditions.begin();
+    while (i != conditions.end())
+    {
+        uint32 elseGroup = (*i)->ElseGroup;
+        bool groupLoaded = false;
+        bool groupMet = true;
+        for (; i != conditions.end() && (*i)->ElseGroup == elseGroup; ++i)
+        {
+            if (!groupMet || !(*i)->isLoaded())
+                continue;
+
+            groupLoaded = true;
+            if ((*i)->ReferenceId)//handle reference
+            {
+                ConditionSpan ref = GetConditionReferences((*i)->ReferenceId);
+                if (!ref.empty())
+                    groupMet = IsObjectMeetToConditionSpan(sourceInfo, ref);
+                else
+                    TC_LOG_DEBUG("condition", "ConditionMgr::IsObjectMeetToConditionSpan %s Reference template -%u not found",
+                        (*i)->ToString().c_str(), (*i)->ReferenceId); // checked at loading, should never happen
+            }
+            else //handle normal condition
+                groupMet = (*i)->Meets(sourceInfo);
+        }
+
+        if (groupLoaded && groupMet)
+            return true;
+    }
+
+    return false;
+}
+
 bool ConditionMgr::CanHaveSourceGroupSet(ConditionSourceType sourceType)
 {
     return (sourceType == CONDITION_SOURCE_TYPE_CREATURE_LOOT_TEMPLATE ||
@@ -813,87 +871,98 @@ bool ConditionMgr::CanHaveSourceIdSet(ConditionSourceType sourceType)
     return (sourceType == CONDITION_SOURCE_TYPE_SMART_EVENT);
 }
 
-ConditionList ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry)
+ConditionSpan ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const
 {
-    ConditionList spellCond;
-    if (sourceType > CONDITION_SOURCE_TYPE_NONE && sourceType < CONDITION_SOURCE_TYPE_MAX)
-    {
-        ConditionContainer::const_iterator itr = ConditionStore.find(sourceType);
-        if (itr != ConditionStore.end())
-        {
-            ConditionTypeContainer::const_iterator i = (*itr).second.find(entry);
-            if (i != (*itr).second.end())
-            {
-                spellCond = (*i).second;
-                TC_LOG_DEBUG("condition", "GetConditionsForNotGroupedEntry: found conditions for type %u and entry %u", uint32(sourceType), entry);
-            }
-        }
-    }
-    return spellCond;
+    if (sourceType <= CONDITION_SOURCE_TYPE_NONE || sourceType >= CONDITION_SOURCE_TYPE_MAX)
+        return ConditionSpan();
+
+    return FindConditions(sourceType, 0, int32(entry), 0);
 }
 
-ConditionList ConditionMgr::GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId)
+ConditionSpan ConditionMgr::GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const
 {
-    ConditionList cond;
-    CreatureSpellConditionContainer::const_iterator itr = SpellClickEventConditionStore.find(creatureId);
-    if (itr != SpellClickEventConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(spellId);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            TC_LOG_DEBUG("condition", "GetConditionsForSpellClickEvent: found conditions for SpellClickEvent entry %u spell %u", creatureId, spellId);
-        }
-    }
-    return cond;
+    return FindConditions(CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT, creatureId, int32(spellId), 0);
 }
 
-ConditionList ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId)
+ConditionSpan ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId) const
 {
-    ConditionList cond;
-    CreatureSpellConditionContainer::const_iterator itr = VehicleSpellConditionStore.find(creatureId);
-    if (itr != VehicleSpellConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(spellId);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            TC_LOG_DEBUG("condition", "GetConditionsForVehicleSpell: found conditions for Vehicle entry %u spell %u", creatureId, spellId);
-        }
-    }
-    return cond;
+    return FindConditions(CONDITION_SOURCE_TYPE_VEHICLE_SPELL, creatureId, int32(spellId), 0);
+}
+
+ConditionSpan ConditionMgr::GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType) const
+{
+    return FindConditions(CONDITION_SOURCE_TYPE_SMART_EVENT, eventId + 1, int32(entryOrGuid), sourceType);
+}
+
+void ConditionMgr::CompileConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType, CompiledConditionList& compiled) const
+{
+    compiled.Conditions = GetConditionsForSmartEvent(entryOrGuid, eventId, sourceType);
+    compiled.LoadCount = _loadCount;
+}
+
+ConditionSpan ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId) const
+{
+    return FindConditions(CONDITION_SOURCE_TYPE_NPC_VENDOR, creatureId, int32(itemId), 0);
+}
+
+bool ConditionMgr::ConditionIndexKey::operator<(ConditionIndexKey const& right) const
+{
+    return std::tie(SourceType, SourceGroup, SourceEntry, SourceId) < std::tie(right.SourceType, right.SourceGroup, right.SourceEntry, right.SourceId);
+}
+
+bool ConditionMgr::ConditionIndexKey::operator==(ConditionIndexKey const& right) const
+{
+    return SourceType == right.SourceType && SourceGroup == right.SourceGroup && SourceEntry == right.SourceEntry && SourceId == right.SourceId;
 }
 
-ConditionList ConditionMgr::GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType)
+void ConditionMgr::AddToIndex(Condition* cond, ConditionSourceType sourceType, uint32 sourceGroup, int32 sourceEntry, uint32 sourceId)
 {
-    ConditionList cond;
-    SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
-    if (itr != SmartEventConditionStore.end())
+    ConditionIndexKey key = { uint32(sourceType), sourceGroup, sourceEntry, sourceId };
+    _pendingIndex.push_back(std::make_pair(key, cond));
+}
+
+void ConditionMgr::BuildIndex()
+{
+    // stable sort keeps the table order of conditions within each ElseGroup
+    std::stable_sort(_pendingIndex.begin(), _pendingIndex.end(), [](std::pair<ConditionIndexKey, Condition*> const& left, std::pair<ConditionIndexKey, Condition*> const& right)
+    {
+        if (!(left.first == right.first))
+            return left.first < right.first;
+
+        return left.second->ElseGroup < right.second->ElseGroup;
+    });
+
+    _indexedConditions.reserve(_pendingIndex.size());
+    for (std::pair<ConditionIndexKey, Condition*> const& pending : _pendingIndex)
     {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(eventId + 1);
-        if (i != (*itr).second.end())
+        if (_conditionIndex.empty() || !(_conditionIndex.back().Key == pending.first))
         {
-            cond = (*i).second;
-            TC_LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid " SI64FMTD " eventId %u", entryOrGuid, eventId);
+            ConditionIndexEntry entry;
+            entry.Key = pending.first;
+            entry.Begin = uint32(_indexedConditions.size());
+            entry.End = entry.Begin;
+            _conditionIndex.push_back(entry);
         }
+
+        _indexedConditions.push_back(pending.second);
+        ++_conditionIndex.back().End;
     }
-    return cond;
+
+    std::vector<std::pair<ConditionIndexKey, Condition*>>().swap(_pendingIndex);
 }
 
-ConditionList ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId)
+ConditionSpan ConditionMgr::FindConditions(ConditionSourceType sourceType, uint32 sourceGroup, int32 sourceEntry, uint32 sourceId) const
 {
-    ConditionList cond;
-    NpcVendorConditionContainer::const_iterator itr = NpcVendorConditionContainerStore.find(creatureId);
-    if (itr != NpcVendorConditionContainerStore.end())
+    ConditionIndexKey key = { uint32(sourceType), sourceGroup, sourceEntry, sourceId };
+    std::vector<ConditionIndexEntry>::const_iterator itr = std::lower_bound(_conditionIndex.begin(), _conditionIndex.end(), key, [](ConditionIndexEntry const& entry, ConditionIndexKey const& key)
     {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(itemId);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            TC_LOG_DEBUG("condition", "GetConditionsForNpcVendorEvent: found conditions for creature entry %u item %u", creatureId, itemId);
-        }
-    }
-    return cond;
+        return entry.Key < key;
+    });
+
+    if (itr == _conditionIndex.end() || !(itr->Key == key))
+        return ConditionSpan();
+
+    return ConditionSpan(_indexedConditions.data() + itr->Begin, _indexedConditions.data() + itr->End);
 }
 
 void ConditionMgr::LoadConditions(bool isReload)
@@ -901,6 +970,7 @@ void ConditionMgr::LoadConditions(bool isReload)
     uint32 oldMSTime = getMSTime();
 
     Clean();
+    ++_loadCount;
 
     //must clear all custom handled cases (groupped types) before reload
     if (isReload)
@@ -1002,12 +1072,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         if (iSourceTypeOrReferenceId < 0)//it is a reference template
         {
             uint32 uRefId = abs(iSourceTypeOrReferenceId);
-            if (ConditionReferenceStore.find(uRefId) == ConditionReferenceStore.end())//make sure we have a list for our conditions, based on reference id
-            {
-                ConditionList mCondList;
-                ConditionReferenceStore[uRefId] = mCondList;
-            }
-            ConditionReferenceStore[uRefId].push_back(cond);//add to reference storage
+            AddToIndex(cond, CONDITION_SOURCE_TYPE_NONE, 0, int32(uRefId), 0);//add to reference storage
             count++;
             continue;
         }//end of reference templates
@@ -1095,7 +1160,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
                 {
-                    SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToIndex(cond, cond->SourceType, cond->SourceGroup, cond->SourceEntry, 0);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -1105,23 +1170,21 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
                 {
-                    VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToIndex(cond, cond->SourceType, cond->SourceGroup, cond->SourceEntry, 0);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
                 }
                 case CONDITION_SOURCE_TYPE_SMART_EVENT:
                 {
-                    //! TODO: PAIR_32 ?
-                    std::pair<int32, uint32> key = std::make_pair(cond->SourceEntry, cond->SourceId);
-                    SmartEventConditionStore[key][cond->SourceGroup].push_back(cond);
+                    AddToIndex(cond, cond->SourceType, cond->SourceGroup, cond->SourceEntry, cond->SourceId);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_NPC_VENDOR:
                 {
-                    NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToIndex(cond, cond->SourceType, cond->SourceGroup, cond->SourceEntry, 0);
                     valid = true;
                     ++count;
                     continue;
@@ -1144,26 +1207,14 @@ void ConditionMgr::LoadConditions(bool isReload)
         }
 
         //handle not grouped conditions
-        //make sure we have a storage list for our SourceType
-        if (ConditionStore.find(cond->SourceType) == ConditionStore.end())
-        {
-            ConditionTypeContainer mTypeMap;
-            ConditionStore[cond->SourceType] = mTypeMap;//add new empty list for SourceType
-        }
-
-        //make sure we have a condition list for our SourceType's entry
-        if (ConditionStore[cond->SourceType].find(cond->SourceEntry) == ConditionStore[cond->SourceType].end())
-        {
-            ConditionList mCondList;
-            ConditionStore[cond->SourceType][cond->SourceEntry] = mCondList;
-        }
-
         //add new Condition to storage based on Type/Entry
-        ConditionStore[cond->SourceType][cond->SourceEntry].push_back(cond);
+        AddToIndex(cond, cond->SourceType, 0, cond->SourceEntry, 0);
         ++count;
     }
     while (result->NextRow());
 
+    BuildIndex();
+
     TC_LOG_INFO("server.loading", ">> Loaded %u conditions in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -2139,79 +2190,11 @@ void ConditionMgr::LogUselessConditionValue(Condition* cond, uint8 index, uint32
 
 void ConditionMgr::Clean()
 {
-    for (ConditionReferenceContainer::iterator itr = ConditionReferenceStore.begin(); itr != ConditionReferenceStore.end(); ++itr)
-    {
-        for (ConditionList::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            delete *it;
-        itr->second.clear();
-    }
-
-    ConditionReferenceStore.clear();
-
-    for (ConditionContainer::iterator itr = ConditionStore.begin(); itr != ConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    ConditionStore.clear();
-
-    for (CreatureSpellConditionContainer::iterator itr = VehicleSpellConditionStore.begin(); itr != VehicleSpellConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    VehicleSpellConditionStore.clear();
-
-    for (SmartEventConditionContainer::iterator itr = SmartEventConditionStore.begin(); itr != SmartEventConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    SmartEventConditionStore.clear();
-
-    for (CreatureSpellConditionContainer::iterator itr = SpellClickEventConditionStore.begin(); itr != SpellClickEventConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    SpellClickEventConditionStore.clear();
-
-    for (NpcVendorConditionContainer::iterator itr = NpcVendorConditionContainerStore.begin(); itr != NpcVendorConditionContainerStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
+    for (std::vector<Condition*>::const_iterator itr = _indexedConditions.begin(); itr != _indexedConditions.end(); ++itr)
+        delete *itr;
 
-    NpcVendorConditionContainerStore.clear();
+    _indexedConditions.clear();
+    _conditionIndex.clear();
 
     // this is a BIG hack, feel free to fix it if you can figure out the ConditionMgr ;)
     for (std::list<Condition*>::const_iterator itr = AllocatedMemoryStore.begin(); itr != AllocatedMemoryStore.end(); ++itr)
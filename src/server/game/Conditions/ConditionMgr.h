@@ -24,6 +24,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 class Player;
 class Unit;
@@ -112,16 +113,16 @@ enum ConditionTypes
 
     The following steps only apply if your condition can be grouped:
 
-    Step 7: Determine how you are going to store your conditions. You need to add a new storage container
-            for it in ConditionMgr class, along with a function like:
-            ConditionList GetConditionsForXXXYourNewSourceTypeXXX(parameters...)
+    Step 7: Determine how you are going to store your conditions. Conditions kept by ConditionMgr itself
+            are added to its index in ConditionMgr::LoadConditions with ConditionMgr::AddToIndex, along
+            with a function like:
+            ConditionSpan GetConditionsForXXXYourNewSourceTypeXXX(parameters...)
 
             The above function should be placed in upper level (practical) code that actually
             checks the conditions.
 
-    Step 8: Implement loading for your source type in ConditionMgr::LoadConditions.
-
-    Step 9: Implement memory cleaning for your source type in ConditionMgr::Clean.
+    Step 8: If your conditions are stored outside of ConditionMgr instead, implement loading for your
+            source type in ConditionMgr::LoadConditions and memory cleaning in ConditionMgr::Clean.
 */
 enum ConditionSourceType
 {
@@ -238,13 +239,36 @@ struct Condition
 };
 
 typedef std::list<Condition*> ConditionList;
-typedef std::map<uint32, ConditionList> ConditionTypeContainer;
-typedef std::map<ConditionSourceType, ConditionTypeContainer> ConditionContainer;
-typedef std::map<uint32, ConditionTypeContainer> CreatureSpellConditionContainer;
-typedef std::map<uint32, ConditionTypeContainer> NpcVendorConditionContainer;
-typedef std::map<std::pair<int32, uint32 /*SAI source_type*/>, ConditionTypeContainer> SmartEventConditionContainer;
 
-typedef std::map<uint32, ConditionList> ConditionReferenceContainer;//only used for references
+/// Non-owning view of the conditions ConditionMgr stores for one source, sorted by ElseGroup.
+/// Conditions are freed on reload, views must not be kept past ConditionMgr::GetLoadCount changing.
+class ConditionSpan
+{
+    public:
+        typedef Condition* const* const_iterator;
+
+        ConditionSpan() : _begin(NULL), _end(NULL) { }
+        ConditionSpan(const_iterator begin, const_iterator end) : _begin(begin), _end(end) { }
+
+        const_iterator begin() const { return _begin; }
+        const_iterator end() const { return _end; }
+        bool empty() const { return _begin == _end; }
+        size_t size() const { return size_t(_end - _begin); }
+
+    private:
+        const_iterator _begin;
+        const_iterator _end;
+};
+
+/// Conditions of one source looked up once for repeated evaluation, see ConditionMgr::CompileConditionsForSmartEvent.
+/// Has to be looked up again once ConditionMgr::GetLoadCount changes.
+struct CompiledConditionList
+{
+    CompiledConditionList() : LoadCount(0) { }
+
+    ConditionSpan Conditions;
+    uint32 LoadCount;
+};
 
 class ConditionMgr
 {
@@ -261,19 +285,26 @@ class ConditionMgr
 
         void LoadConditions(bool isReload = false);
         bool isConditionTypeValid(Condition* cond);
-        ConditionList GetConditionReferences(uint32 refId);
+        ConditionSpan GetConditionReferences(uint32 refId) const;
 
         uint32 GetSearcherTypeMaskForConditionList(ConditionList const& conditions);
         bool IsObjectMeetToConditions(WorldObject* object, ConditionList const& conditions);
         bool IsObjectMeetToConditions(WorldObject* object1, WorldObject* object2, ConditionList const& conditions);
         bool IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, ConditionList const& conditions);
+        bool IsObjectMeetToConditions(WorldObject* object, ConditionSpan conditions);
+        bool IsObjectMeetToConditions(WorldObject* object1, WorldObject* object2, ConditionSpan conditions);
+        bool IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, ConditionSpan conditions);
         static bool CanHaveSourceGroupSet(ConditionSourceType sourceType);
         static bool CanHaveSourceIdSet(ConditionSourceType sourceType);
-        ConditionList GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry);
-        ConditionList GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId);
-        ConditionList GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType);
-        ConditionList GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId);
-        ConditionList GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId);
+        ConditionSpan GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const;
+        ConditionSpan GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const;
+        ConditionSpan GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType) const;
+        ConditionSpan GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId) const;
+        ConditionSpan GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId) const;
+
+        void CompileConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType, CompiledConditionList& compiled) const;
+        /// Incremented every time conditions are (re)loaded
+        uint32 GetLoadCount() const { return _loadCount; }
 
         struct ConditionTypeInfo
         {
@@ -286,24 +317,48 @@ class ConditionMgr
         static ConditionTypeInfo const StaticConditionTypeData[CONDITION_MAX];
 
     private:
+        /// Identifies the source of indexed conditions, reference templates use CONDITION_SOURCE_TYPE_NONE and the reference id as SourceEntry
+        struct ConditionIndexKey
+        {
+            uint32 SourceType;
+            uint32 SourceGroup;
+            int32 SourceEntry;
+            uint32 SourceId;
+
+            bool operator<(ConditionIndexKey const& right) const;
+            bool operator==(ConditionIndexKey const& right) const;
+        };
+
+        struct ConditionIndexEntry
+        {
+            ConditionIndexKey Key;
+            uint32 Begin;                                   // range in _indexedConditions
+            uint32 End;
+        };
+
         bool isSourceTypeValid(Condition* cond);
         bool addToLootTemplate(Condition* cond, LootTemplate* loot);
         bool addToGossipMenus(Condition* cond);
         bool addToGossipMenuItems(Condition* cond);
         bool addToSpellImplicitTargetConditions(Condition* cond);
         bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions);
+        bool IsObjectMeetToConditionSpan(ConditionSourceInfo& sourceInfo, ConditionSpan conditions);
+
+        void AddToIndex(Condition* cond, ConditionSourceType sourceType, uint32 sourceGroup, int32 sourceEntry, uint32 sourceId);
+        void BuildIndex();
+        ConditionSpan FindConditions(ConditionSourceType sourceType, uint32 sourceGroup, int32 sourceEntry, uint32 sourceId) const;
 
         static void LogUselessConditionValue(Condition* cond, uint8 index, uint32 value);
 
         void Clean(); // free up resources
         std::list<Condition*> AllocatedMemoryStore; // some garbage collection :)
 
-        ConditionContainer                ConditionStore;
-        ConditionReferenceContainer       ConditionReferenceStore;
-        CreatureSpellConditionContainer   VehicleSpellConditionStore;
-        CreatureSpellConditionContainer   SpellClickEventConditionStore;
-        NpcVendorConditionContainer       NpcVendorConditionContainerStore;
-        SmartEventConditionContainer      SmartEventConditionStore;
+        // conditions not stored in loot templates, gossip menus or spells are kept in one array sorted by source and ElseGroup
+        std::vector<Condition*> _indexedConditions;
+        std::vector<ConditionIndexEntry> _conditionIndex;
+        std::vector<std::pair<ConditionIndexKey, Condition*>> _pendingIndex;     // filled while loading, moved into the index by BuildIndex
+
+        uint32 _loadCount;
 };
 
 #define sConditionMgr ConditionMgr::instance()
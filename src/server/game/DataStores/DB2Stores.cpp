@@ -82,6 +82,8 @@ TaxiPathNodesByPath                         sTaxiPathNodesByPath;
 typedef std::list<std::string> DB2StoreProblemList;
 
 uint32 DB2FilesCount = 0;
+std::size_t DB2AllocatedMemory = 0;
+std::size_t DB2MappedMemory = 0;
 
 template<class T>
 inline void LoadDB2(uint32& availableDb2Locales, DB2StoreProblemList& errlist, DB2Manager::StorageMap& stores, DB2Storage<T>* storage, std::string const& db2_path)
@@ -108,6 +110,11 @@ inline void LoadDB2(uint32& availableDb2Locales, DB2StoreProblemList& errlist, D
 
             storage->LoadStringsFromDB(i);
         }
+
+        TC_LOG_DEBUG("server.loading", "DB2 %s: " SZFMTD " KB allocated, " SZFMTD " KB mapped", storage->GetFileName().c_str(),
+            storage->GetAllocatedMemory() / 1024, storage->GetMappedMemory() / 1024);
+        DB2AllocatedMemory += storage->GetAllocatedMemory();
+        DB2MappedMemory += storage->GetMappedMemory();
     }
     else
     {
@@ -359,7 +366,8 @@ void DB2Manager::LoadStores(std::string const& dataPath)
         exit(1);
     }
 
-    TC_LOG_INFO("server.loading", ">> Initialized %d DB2 data stores in %u ms", DB2FilesCount, GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Initialized %d DB2 data stores in %u ms (" SZFMTD " KB allocated, " SZFMTD " KB mapped from files)", DB2FilesCount, GetMSTimeDiffToNow(oldMSTime),
+        DB2AllocatedMemory / 1024, DB2MappedMemory / 1024);
 }
 
 DB2StorageBase const* DB2Manager::GetStorage(uint32 type) const
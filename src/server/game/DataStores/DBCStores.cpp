@@ -247,6 +247,8 @@ DBCStorage <PhaseEntry> sPhaseStore(PhaseEntryfmt);
 typedef std::list<std::string> StoreProblemList;
 
 uint32 DBCFileCount = 0;
+std::size_t DBCAllocatedMemory = 0;
+std::size_t DBCMappedMemory = 0;
 
 template<class T>
 inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, std::string const* customFormat = NULL, std::string const* customIndexName = NULL)
@@ -277,6 +279,11 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
             if (!storage.LoadStringsFrom(localizedName.c_str()))
                 availableDbcLocales &= ~(1<<i);             // mark as not available for speedup next checks
         }
+
+        TC_LOG_DEBUG("server.loading", "DBC %s: " SZFMTD " KB allocated, " SZFMTD " KB mapped", filename.c_str(),
+            storage.GetAllocatedMemory() / 1024, storage.GetMappedMemory() / 1024);
+        DBCAllocatedMemory += storage.GetAllocatedMemory();
+        DBCMappedMemory += storage.GetMappedMemory();
     }
     else
     {
@@ -700,7 +707,8 @@ void LoadDBCStores(const std::string& dataPath)
         exit(1);
     }
 
-    TC_LOG_INFO("server.loading", ">> Initialized %d DBC data stores in %u ms", DBCFileCount, GetMSTimeDiffToNow(oldMSTime));
+    TC_LOG_INFO("server.loading", ">> Initialized %d DBC data stores in %u ms (" SZFMTD " KB allocated, " SZFMTD " KB mapped from files)", DBCFileCount, GetMSTimeDiffToNow(oldMSTime),
+        DBCAllocatedMemory / 1024, DBCMappedMemory / 1024);
 }
 
 std::string const& GetRandomCharacterName(uint8 race, uint8 gender)
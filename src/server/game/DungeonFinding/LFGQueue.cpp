@@ -54,6 +54,53 @@ std::string ConcatenateGuids(GuidList const& check)
     return o.str();
 }
 
+LfgCompatibilityKey::LfgCompatibilityKey(GuidList const& guids): count(0)
+{
+    // need the guids in order to avoid duplicates
+    for (GuidList::const_iterator itr = guids.begin(); itr != guids.end() && count < MAX_GUIDS; ++itr)
+    {
+        uint8 i = count;
+        for (; i > 0 && *itr < this->guids[i - 1]; --i)
+            this->guids[i] = this->guids[i - 1];
+
+        this->guids[i] = *itr;
+        ++count;
+    }
+}
+
+bool LfgCompatibilityKey::Contains(ObjectGuid guid) const
+{
+    return std::find(guids, guids + count, guid) != guids + count;
+}
+
+std::string LfgCompatibilityKey::ToString() const
+{
+    std::ostringstream o;
+    for (uint8 i = 0; i < count; ++i)
+    {
+        if (i)
+            o << '|';
+        o << guids[i];
+    }
+
+    return o.str();
+}
+
+bool LfgCompatibilityKey::operator==(LfgCompatibilityKey const& right) const
+{
+    return count == right.count && std::equal(guids, guids + count, right.guids);
+}
+
+std::size_t LfgCompatibilityKeyHash::operator()(LfgCompatibilityKey const& key) const
+{
+    std::hash<ObjectGuid> hasher;
+    std::size_t hash = key.count;
+    for (uint8 i = 0; i < key.count; ++i)
+        boost::hash_combine(hash, hasher(key.guids[i]));
+
+    return hash;
+}
+
 char const* GetCompatibleString(LfgCompatibility compatibles)
 {
     switch (compatibles)
@@ -101,17 +148,13 @@ void LFGQueue::RemoveFromQueue(ObjectGuid guid)
     RemoveFromCurrentQueue(guid);
     RemoveFromCompatibles(guid);
 
-    std::ostringstream o;
-    o << guid;
-    std::string sguid = o.str();
-
     LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
     for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
         if (itr->first != guid)
         {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
+            if (itr->second.bestCompatible.Contains(guid))
             {
-                itr->second.bestCompatible.clear();
+                itr->second.bestCompatible = LfgCompatibilityKey();
                 FindBestCompatibleInQueue(itr);
             }
         }
@@ -190,43 +233,81 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 */
 void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
     TC_LOG_DEBUG("lfg.queue.data.compatibles.remove", "Removing %s", guid.ToString().c_str());
-    for (LfgCompatibleContainer::iterator itNext = CompatibleMapStore.begin(); itNext != CompatibleMapStore.end();)
+    LfgCompatibleKeysContainer::iterator itr = CompatibleKeysStore.find(guid);
+    if (itr == CompatibleKeysStore.end())
+        return;
+
+    std::vector<LfgCompatibilityKey> keys;
+    keys.swap(itr->second);
+    CompatibleKeysStore.erase(itr);
+
+    // drop each combination from the key lists of its other guids too, a guid queueing again starts with a clean list
+    for (LfgCompatibilityKey const& key : keys)
     {
-        LfgCompatibleContainer::iterator it = itNext++;
-        if (std::string::npos != it->first.find(strGuid))
-            CompatibleMapStore.erase(it);
+        CompatibleMapStore.erase(key);
+
+        for (uint8 i = 0; i < key.size(); ++i)
+        {
+            if (key.guids[i] == guid)
+                continue;
+
+            LfgCompatibleKeysContainer::iterator itrOther = CompatibleKeysStore.find(key.guids[i]);
+            if (itrOther == CompatibleKeysStore.end())
+                continue;
+
+            std::vector<LfgCompatibilityKey>& otherKeys = itrOther->second;
+            std::vector<LfgCompatibilityKey>::iterator itrKey = std::find(otherKeys.begin(), otherKeys.end(), key);
+            if (itrKey != otherKeys.end())
+            {
+                *itrKey = otherKeys.back();
+                otherKeys.pop_back();
+            }
+
+            if (otherKeys.empty())
+                CompatibleKeysStore.erase(itrOther);
+        }
     }
 }
 
+/**
+   Returns the cached compatibility data of a list of guids, creating it if not cached yet
+
+   @param[in]     key Sorted guids
+*/
+LfgCompatibilityData& LFGQueue::InsertCompatibilityData(LfgCompatibilityKey const& key)
+{
+    std::pair<LfgCompatibleContainer::iterator, bool> result = CompatibleMapStore.insert(std::make_pair(key, LfgCompatibilityData()));
+    if (result.second)
+        for (uint8 i = 0; i < key.size(); ++i)
+            CompatibleKeysStore[key.guids[i]].push_back(key);
+
+    return result.first->second;
+}
+
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted guids
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles)
 {
-    LfgCompatibilityData& data = CompatibleMapStore[key];
-    data.compatibility = compatibles;
+    InsertCompatibilityData(key).compatibility = compatibles;
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& data)
 {
-    CompatibleMapStore[key] = data;
+    InsertCompatibilityData(key) = data;
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Sorted guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -235,7 +316,7 @@ LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
+LfgCompatibilityData* LFGQueue::GetCompatibilityData(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -278,17 +359,17 @@ uint8 LFGQueue::FindGroups()
 */
 LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 {
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
+    LfgCompatibilityKey key(check);
+    LfgCompatibility compatibles = check.size() > LfgCompatibilityKey::MAX_GUIDS ? LFG_COMPATIBILITY_PENDING : GetCompatibles(key);
 
-    TC_LOG_DEBUG("lfg.queue.match.check", "Guids: (%s): %s - all(%s)", strGuids.c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
+    TC_LOG_DEBUG("lfg.queue.match.check", "Guids: (%s): %s - all(%s)", ConcatenateGuids(check).c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
     if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
         compatibles = CheckCompatibility(check);
 
     if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
     {
-        TC_LOG_DEBUG("lfg.queue.match.check", "Guids: (%s) compatibles (cached) changed from bad states to match", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+        TC_LOG_DEBUG("lfg.queue.match.check", "Guids: (%s) compatibles (cached) changed from bad states to match", key.ToString().c_str());
+        SetCompatibles(key, LFG_COMPATIBLES_MATCH);
         return LFG_COMPATIBLES_MATCH;
     }
 
@@ -316,7 +397,7 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 */
 LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 {
-    std::string strGuids = ConcatenateGuids(check);
+    LfgCompatibilityKey key(check);
     LfgProposal proposal;
     LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
@@ -325,7 +406,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     // Check for correct size
     if (check.size() > MAX_GROUP_SIZE || check.empty())
     {
-        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s): Size wrong - Not compatibles", strGuids.c_str());
+        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s): Size wrong - Not compatibles", ConcatenateGuids(check).c_str());
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
     }
 
@@ -336,11 +417,14 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         check.pop_front();
 
         // Check all-but-new compatibilities (New, A, B, C, D) --> check(A, B, C, D)
-        LfgCompatibility child_compatibles = CheckCompatibility(check);
+        // usually cached already, (A, B, C, D) was checked when D joined the queue
+        LfgCompatibility child_compatibles = GetCompatibles(LfgCompatibilityKey(check));
+        if (child_compatibles == LFG_COMPATIBILITY_PENDING)
+            child_compatibles = CheckCompatibility(check);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) child %s not compatibles", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, child_compatibles);
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) child %s not compatibles", key.ToString().c_str(), ConcatenateGuids(check).c_str());
+            SetCompatibles(key, child_compatibles);
             return child_compatibles;
         }
         check.push_front(frontGuid);
@@ -377,29 +461,29 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     // Group with less that MAX_GROUP_SIZE members always compatible
     if (check.size() == 1 && numPlayers != MAX_GROUP_SIZE)
     {
-        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) single group. Compatibles", strGuids.c_str());
+        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) single group. Compatibles", key.ToString().c_str());
         LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(check.front());
 
         LfgCompatibilityData data(LFG_COMPATIBLES_WITH_LESS_PLAYERS);
         data.roles = itQueue->second.roles;
         LFGMgr::CheckGroupRoles(data.roles);
 
-        UpdateBestCompatibleInQueue(itQueue, strGuids, data.roles);
-        SetCompatibilityData(strGuids, data);
+        UpdateBestCompatibleInQueue(itQueue, key, data.roles);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     if (numLfgGroups > 1)
     {
-        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) More than one Lfggroup (%u)", key.ToString().c_str(), numLfgGroups);
+        SetCompatibles(key, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > MAX_GROUP_SIZE)
     {
-        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Too much players (%u)", strGuids.c_str(), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Too much players (%u)", key.ToString().c_str(), numPlayers);
+        SetCompatibles(key, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
@@ -426,8 +510,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
-            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) not compatible, %u players are ignoring each other", strGuids.c_str(), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) not compatible, %u players are ignoring each other", key.ToString().c_str(), playersize);
+            SetCompatibles(key, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
@@ -438,8 +522,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
             for (LfgRolesMap::const_iterator it = debugRoles.begin(); it != debugRoles.end(); ++it)
                 o << ", " << it->first << ": " << GetRolesString(it->second);
 
-            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Roles not compatible%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Roles not compatible%s", key.ToString().c_str(), o.str().c_str());
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
 
@@ -458,8 +542,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 
         if (proposalDungeons.empty())
         {
-            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) No compatible dungeons%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) No compatible dungeons%s", key.ToString().c_str(), o.str().c_str());
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
     }
@@ -475,14 +559,14 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     // Enough players?
     if (numPlayers != MAX_GROUP_SIZE)
     {
-        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Compatibles but not enough players(%u)", strGuids.c_str(), numPlayers);
+        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Compatibles but not enough players(%u)", key.ToString().c_str(), numPlayers);
         LfgCompatibilityData data(LFG_COMPATIBLES_WITH_LESS_PLAYERS);
         data.roles = proposalRoles;
 
         for (GuidList::const_iterator itr = check.begin(); itr != check.end(); ++itr)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), key, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
@@ -492,8 +576,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 
     if (!sLFGMgr->AllQueued(check))
     {
-        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Group MATCH but can't create proposal!", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) Group MATCH but can't create proposal!", key.ToString().c_str());
+        SetCompatibles(key, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -534,8 +618,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 
     sLFGMgr->AddProposal(proposal);
 
-    TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) MATCH! Group formed", strGuids.c_str());
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: (%s) MATCH! Group formed", key.ToString().c_str());
+    SetCompatibles(key, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -630,7 +714,7 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
     o << "Compatible Map size: " << CompatibleMapStore.size() << "\n";
     if (full)
         for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
+            o << "(" << itr->first.ToString() << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
 
     return o.str();
 }
@@ -638,32 +722,29 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
 {
     TC_LOG_DEBUG("lfg.queue.compatibles.find", "%s", itrQueue->first.ToString().c_str());
-    std::ostringstream o;
-    o << itrQueue->first;
-    std::string sguid = o.str();
+    LfgCompatibleKeysContainer::iterator itrKeys = CompatibleKeysStore.find(itrQueue->first);
+    if (itrKeys == CompatibleKeysStore.end())
+        return;
 
-    for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS &&
-            std::string::npos != itr->first.find(sguid))
-        {
+    for (LfgCompatibilityKey const& key : itrKeys->second)
+    {
+        LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.find(key);
+        ASSERT(itr != CompatibleMapStore.end());
+
+        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS)
             UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
-        }
+    }
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
-
-    if (size <= storedSize)
+    if (key.size() <= queueData.bestCompatible.size())
         return;
 
     TC_LOG_DEBUG("lfg.queue.compatibles.update", "Changed (%s) to (%s) as best compatible group for %s",
-        queueData.bestCompatible.c_str(), key.c_str(), itrQueue->first.ToString().c_str());
+        queueData.bestCompatible.ToString().c_str(), key.ToString().c_str(), itrQueue->first.ToString().c_str());
 
     queueData.bestCompatible = key;
     queueData.tanks = LFG_TANKS_NEEDED;
@@ -19,6 +19,7 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include <unordered_map>
 
 namespace lfg
 {
@@ -37,6 +38,30 @@ enum LfgCompatibility
     LFG_COMPATIBLES_MATCH                                  // Must be the last one
 };
 
+/// Sorted set of queued guids (players or groups) checked together, key of the compatibility cache
+struct LfgCompatibilityKey
+{
+    enum { MAX_GUIDS = 5 };                                // MAX_GROUP_SIZE, every queued guid brings at least one player
+
+    LfgCompatibilityKey(): count(0) { }
+    explicit LfgCompatibilityKey(GuidList const& guids);
+
+    bool Contains(ObjectGuid guid) const;
+    uint8 size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::string ToString() const;
+
+    bool operator==(LfgCompatibilityKey const& right) const;
+
+    ObjectGuid guids[MAX_GUIDS];
+    uint8 count;
+};
+
+struct LfgCompatibilityKeyHash
+{
+    std::size_t operator()(LfgCompatibilityKey const& key) const;
+};
+
 struct LfgCompatibilityData
 {
     LfgCompatibilityData(): compatibility(LFG_COMPATIBILITY_PENDING) { }
@@ -66,7 +91,7 @@ struct LfgQueueData
     uint8 dps;                                             ///< Dps needed
     LfgDungeonSet dungeons;                                ///< Selected Player/Group Dungeon/s
     LfgRolesMap roles;                                     ///< Selected Player Role/s
-    std::string bestCompatible;                            ///< Best compatible combination of people queued
+    LfgCompatibilityKey bestCompatible;                    ///< Best compatible combination of people queued
 };
 
 struct LfgWaitTime
@@ -77,7 +102,8 @@ struct LfgWaitTime
 };
 
 typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
-typedef std::map<std::string, LfgCompatibilityData> LfgCompatibleContainer;
+typedef std::unordered_map<LfgCompatibilityKey, LfgCompatibilityData, LfgCompatibilityKeyHash> LfgCompatibleContainer;
+typedef std::unordered_map<ObjectGuid, std::vector<LfgCompatibilityKey>> LfgCompatibleKeysContainer;
 typedef std::map<ObjectGuid, LfgQueueData> LfgQueueDataContainer;
 
 /**
@@ -111,21 +137,20 @@ class LFGQueue
         std::string DumpCompatibleInfo(bool full = false) const;
 
     private:
-        void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
-
         void AddToNewQueue(ObjectGuid guid);
         void AddToCurrentQueue(ObjectGuid guid);
         void RemoveFromNewQueue(ObjectGuid guid);
         void RemoveFromCurrentQueue(ObjectGuid guid);
 
-        void SetCompatibles(std::string const& key, LfgCompatibility compatibles);
-        LfgCompatibility GetCompatibles(std::string const& key);
+        void SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles);
+        LfgCompatibility GetCompatibles(LfgCompatibilityKey const& key);
         void RemoveFromCompatibles(ObjectGuid guid);
 
-        void SetCompatibilityData(std::string const& key, LfgCompatibilityData const& compatibles);
-        LfgCompatibilityData* GetCompatibilityData(std::string const& key);
+        void SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& compatibles);
+        LfgCompatibilityData* GetCompatibilityData(LfgCompatibilityKey const& key);
+        LfgCompatibilityData& InsertCompatibilityData(LfgCompatibilityKey const& key);
         void FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
-        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles);
+        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles);
 
         LfgCompatibility FindNewGroups(GuidList& check, GuidList& all);
         LfgCompatibility CheckCompatibility(GuidList check);
@@ -133,6 +158,7 @@ class LFGQueue
         // Queue
         LfgQueueDataContainer QueueDataStore;              ///< Queued groups
         LfgCompatibleContainer CompatibleMapStore;         ///< Compatible dungeons
+        LfgCompatibleKeysContainer CompatibleKeysStore;    ///< Keys of CompatibleMapStore each guid is part of
 
         LfgWaitTimesContainer waitTimesAvgStore;           ///< Average wait time to find a group queuing as multiple roles
         LfgWaitTimesContainer waitTimesTankStore;          ///< Average wait time to find a group queuing as tank
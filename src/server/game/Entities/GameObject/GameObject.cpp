@@ -2287,85 +2287,85 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     if (GetOwnerGUID() == target->GetGUID())
         visibleFlag |= UF_FLAG_OWNER;
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    UpdateFieldFlagMasks const& flagMasks = GetUpdateFieldFlagMasks(flags);
+    for (uint32 block = 0; block < updateMask.GetBlockCount(); ++block)
+        updateMask.SetBlock(block, GetUpdateFieldBlock(updateType, block, m_valuesCount, flagMasks, visibleFlag));
+
+    if (forcedFlags)
+        updateMask.SetBit(GAMEOBJECT_FLAGS);
+
+    for (uint32 index = updateMask.FindNextSetBit(0); index < m_valuesCount; index = updateMask.FindNextSetBit(index + 1))
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-            (index == GAMEOBJECT_FLAGS && forcedFlags))
+        if (index == OBJECT_DYNAMIC_FLAGS)
         {
-            updateMask.SetBit(index);
-
-            if (index == OBJECT_DYNAMIC_FLAGS)
+            uint16 dynFlags = 0;
+            int16 pathProgress = -1;
+            switch (GetGoType())
             {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_CHEST:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    else if (targetIsGM)
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_GENERIC:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                case GAMEOBJECT_TYPE_TRANSPORT:
+                case GAMEOBJECT_TYPE_MAP_OBJ_TRANSPORT:
                 {
-                    case GAMEOBJECT_TYPE_QUESTGIVER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                    case GAMEOBJECT_TYPE_MAP_OBJ_TRANSPORT:
+                    if (uint32 transportPeriod = GetTransportPeriod())
                     {
-                        if (uint32 transportPeriod = GetTransportPeriod())
-                        {
-                            float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
-                            pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
-                        }
-                        break;
+                        float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
+                        pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
                     }
-                    default:
-                        break;
+                    break;
                 }
-
-                fieldBuffer << uint16(dynFlags);
-                fieldBuffer << int16(pathProgress);
+                default:
+                    break;
             }
-            else if (index == GAMEOBJECT_FLAGS)
-            {
-                uint32 flags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                    if (GetGOInfo()->chest.usegrouplootrules && !IsLootAllowedFor(target))
-                        flags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
 
-                fieldBuffer << flags;
-            }
-            else if (index == GAMEOBJECT_LEVEL)
-            {
-                if (isStoppableTransport)
-                    fieldBuffer << uint32(m_goValue.Transport.PathProgress);
-                else
-                    fieldBuffer << m_uint32Values[index];
-            }
-            else if (index == GAMEOBJECT_BYTES_1)
+            fieldBuffer << uint16(dynFlags);
+            fieldBuffer << int16(pathProgress);
+        }
+        else if (index == GAMEOBJECT_FLAGS)
+        {
+            uint32 flags = m_uint32Values[GAMEOBJECT_FLAGS];
+            if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
+                if (GetGOInfo()->chest.usegrouplootrules && !IsLootAllowedFor(target))
+                    flags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+
+            fieldBuffer << flags;
+        }
+        else if (index == GAMEOBJECT_LEVEL)
+        {
+            if (isStoppableTransport)
+                fieldBuffer << uint32(m_goValue.Transport.PathProgress);
+            else
+                fieldBuffer << m_uint32Values[index];
+        }
+        else if (index == GAMEOBJECT_BYTES_1)
+        {
+            uint32 bytes1 = m_uint32Values[index];
+            if (isStoppableTransport && GetGoState() == GO_STATE_TRANSPORT_ACTIVE)
             {
-                uint32 bytes1 = m_uint32Values[index];
-                if (isStoppableTransport && GetGoState() == GO_STATE_TRANSPORT_ACTIVE)
+                if ((m_goValue.Transport.StateUpdateTimer / 20000) & 1)
                 {
-                    if ((m_goValue.Transport.StateUpdateTimer / 20000) & 1)
-                    {
-                        bytes1 &= 0xFFFFFF00;
-                        bytes1 |= GO_STATE_TRANSPORT_STOPPED;
-                    }
+                    bytes1 &= 0xFFFFFF00;
+                    bytes1 |= GO_STATE_TRANSPORT_STOPPED;
                 }
-
-                fieldBuffer << bytes1;
             }
-            else
-                fieldBuffer << m_uint32Values[index];                // other cases
+
+            fieldBuffer << bytes1;
         }
+        else
+            fieldBuffer << m_uint32Values[index];                // other cases
     }
 
     *data << uint8(updateMask.GetBlockCount());
@@ -763,15 +763,12 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
     ASSERT(flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-    {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
-        {
-            updateMask.SetBit(index);
-            fieldBuffer << m_uint32Values[index];
-        }
-    }
+    UpdateFieldFlagMasks const& flagMasks = GetUpdateFieldFlagMasks(flags);
+    for (uint32 block = 0; block < updateMask.GetBlockCount(); ++block)
+        updateMask.SetBlock(block, GetUpdateFieldBlock(updateType, block, m_valuesCount, flagMasks, visibleFlag));
+
+    for (uint32 index = updateMask.FindNextSetBit(0); index < m_valuesCount; index = updateMask.FindNextSetBit(index + 1))
+        fieldBuffer << m_uint32Values[index];
 
     *data << uint8(updateMask.GetBlockCount());
     updateMask.AppendToPacket(data);
@@ -922,6 +919,28 @@ uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
     return visibleFlag;
 }
 
+uint32 Object::GetUpdateFieldBlock(uint8 updateType, uint32 block, uint32 valuesCount, UpdateFieldFlagMasks const& flagMasks, uint32 visibleFlag, uint32 extraNotifyFlags /*= 0*/) const
+{
+    uint32 firstIndex = block * UpdateMask::CLIENT_UPDATE_MASK_BITS;
+    uint32 changed = 0;
+    if (updateType == UPDATETYPE_VALUES)
+        changed = _changesMask.GetBlock(block);
+    else
+    {
+        for (uint32 i = 0; i < UpdateMask::CLIENT_UPDATE_MASK_BITS && firstIndex + i < valuesCount; ++i)
+            if (m_uint32Values[firstIndex + i])
+                changed |= 1u << i;
+    }
+
+    uint32 bits = (changed & flagMasks.GetBlock(block, visibleFlag)) | flagMasks.GetBlock(block, _fieldNotifyFlags | extraNotifyFlags);
+
+    // the flag tables of units cover player fields too
+    if (valuesCount - firstIndex < UpdateMask::CLIENT_UPDATE_MASK_BITS)
+        bits &= (1u << (valuesCount - firstIndex)) - 1;
+
+    return bits;
+}
+
 uint32 Object::GetDynamicUpdateFieldData(Player const* target, uint32*& flags) const
 {
     uint32 visibleFlag = UF_FLAG_PUBLIC;
@@ -1513,6 +1532,15 @@ void WorldObject::CleanupsBeforeDelete(bool /*finalCleanup*/)
         transport->RemovePassenger(this);
 }
 
+void WorldObject::AddToWorld()
+{
+    if (IsInWorld())
+        return;
+
+    Object::AddToWorld();
+    m_mapHandle = GetMap()->AddToObjectSlots(this);
+}
+
 void WorldObject::RemoveFromWorld()
 {
     if (!IsInWorld())
@@ -1520,6 +1548,13 @@ void WorldObject::RemoveFromWorld()
 
     DestroyForNearbyPlayers();
 
+    // corpses may change map while in world and are never given a handle
+    if (!m_mapHandle.IsEmpty())
+    {
+        GetMap()->RemoveFromObjectSlots(m_mapHandle);
+        m_mapHandle = MapObjectHandle();
+    }
+
     Object::RemoveFromWorld();
 }
 
@@ -2809,7 +2844,7 @@ void WorldObject::UpdateAreaPhase()
         {
             if (areaId == GetAreaId())
             {
-                ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_PHASE, phaseId);
+                ConditionSpan conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_PHASE, phaseId);
                 if (sConditionMgr->IsObjectMeetToConditions(this, conditions))
                 {
                     // add new phase if condition passed, true if it wasnt added before
@@ -2885,7 +2920,7 @@ bool WorldObject::SetInPhase(uint32 id, bool update, bool apply)
             {
                 if (id == phaseId)
                 {
-                    ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_PHASE, phaseId);
+                    ConditionSpan conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_PHASE, phaseId);
                     if (sConditionMgr->IsObjectMeetToConditions(this, conditions))
                     {
                         // if area phase passes the condition we should not remove it (ie: if remove called from aura remove)
@@ -3105,7 +3140,7 @@ void WorldObject::RebuildTerrainSwaps()
     // Clear all terrain swaps, will be rebuilt below
     // Reason for this is, multiple phases can have the same terrain swap, we should not remove the swap if another phase still use it
     _terrainSwaps.clear();
-    ConditionList conditions;
+    ConditionSpan conditions;
 
     // Check all applied phases for terrain swap and add it only once
     for (uint32 phaseId : _phases)
@@ -3154,7 +3189,7 @@ void WorldObject::RebuildWorldMapAreaSwaps()
     {
         for (uint32 swap : itr->second)
         {
-            ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_TERRAIN_SWAP, swap);
+            ConditionSpan conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_TERRAIN_SWAP, swap);
             if (sConditionMgr->IsObjectMeetToConditions(this, conditions))
             {
                 for (uint32 map : sObjectMgr->GetTerrainWorldMaps(swap))
@@ -3172,7 +3207,7 @@ void WorldObject::RebuildWorldMapAreaSwaps()
         {
             // add world map swaps for ANY map
 
-            ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_TERRAIN_SWAP, swap);
+            ConditionSpan conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_TERRAIN_SWAP, swap);
 
             if (sConditionMgr->IsObjectMeetToConditions(this, conditions))
             {
@@ -86,6 +86,7 @@ class TempSummon;
 class Transport;
 class Unit;
 class UpdateData;
+class UpdateFieldFlagMasks;
 class WorldObject;
 class WorldPacket;
 class ZoneScript;
@@ -219,6 +220,7 @@ class Object
 
         uint32 GetUpdateFieldData(Player const* target, uint32*& flags) const;
         uint32 GetDynamicUpdateFieldData(Player const* target, uint32*& flags) const;
+        uint32 GetUpdateFieldBlock(uint8 updateType, uint32 block, uint32 valuesCount, UpdateFieldFlagMasks const& flagMasks, uint32 visibleFlag, uint32 extraNotifyFlags = 0) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint32 flags) const;
         virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
@@ -462,8 +464,12 @@ class WorldObject : public Object, public WorldLocation
 
         virtual void Update (uint32 /*time_diff*/) { }
 
+        virtual void AddToWorld() override;
         virtual void RemoveFromWorld() override;
 
+        /// Handle in the object slot table of the map, empty while not in world
+        MapObjectHandle const& GetMapHandle() const { return m_mapHandle; }
+
         void GetNearPoint2D(float &x, float &y, float distance, float absAngle) const;
         void GetNearPoint(WorldObject const* searcher, float &x, float &y, float &z, float searcher_size, float distance2d, float absAngle) const;
         void GetClosePoint(float &x, float &y, float &z, float size, float distance2d = 0, float angle = 0) const;
@@ -671,6 +677,7 @@ class WorldObject : public Object, public WorldLocation
         virtual bool IsAlwaysDetectableFor(WorldObject const* /*seer*/) const { return false; }
     private:
         Map* m_currMap;                                    //current object's Map location
+        MapObjectHandle m_mapHandle;
 
         //uint32 m_mapId;                                     // object at map with map_id
         uint32 m_InstanceId;                                // in map copy with instance id
@@ -16,6 +16,7 @@
  */
 
 #include "UpdateFieldFlags.h"
+#include "Errors.h"
 
 uint32 ItemUpdateFieldFlags[CONTAINER_END] =
 {
@@ -3757,3 +3758,43 @@ uint32 ConversationDynamicUpdateFieldFlags[CONVERSATION_DYNAMIC_END] =
     UF_FLAG_0x100,                                          // CONVERSATION_DYNAMIC_FIELD_LINES
 };
 
+UpdateFieldFlagMasks::UpdateFieldFlagMasks(uint32 const* flags, uint32 count)
+{
+    for (uint32 i = 0; i < MAX_FLAG_BITS; ++i)
+        _blocks[i].resize((count + 31) / 32, 0);
+
+    for (uint32 index = 0; index < count; ++index)
+        for (uint32 i = 0; i < MAX_FLAG_BITS; ++i)
+            if (flags[index] & (1 << i))
+                _blocks[i][index / 32] |= 1u << (index % 32);
+}
+
+static UpdateFieldFlagMasks const ItemUpdateFieldFlagMasks(ItemUpdateFieldFlags, CONTAINER_END);
+static UpdateFieldFlagMasks const UnitUpdateFieldFlagMasks(UnitUpdateFieldFlags, PLAYER_END);
+static UpdateFieldFlagMasks const GameObjectUpdateFieldFlagMasks(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+static UpdateFieldFlagMasks const DynamicObjectUpdateFieldFlagMasks(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+static UpdateFieldFlagMasks const CorpseUpdateFieldFlagMasks(CorpseUpdateFieldFlags, CORPSE_END);
+static UpdateFieldFlagMasks const AreaTriggerUpdateFieldFlagMasks(AreaTriggerUpdateFieldFlags, AREATRIGGER_END);
+static UpdateFieldFlagMasks const SceneObjectUpdateFieldFlagMasks(SceneObjectUpdateFieldFlags, SCENEOBJECT_END);
+static UpdateFieldFlagMasks const ConversationUpdateFieldFlagMasks(ConversationUpdateFieldFlags, CONVERSATION_END);
+
+UpdateFieldFlagMasks const& GetUpdateFieldFlagMasks(uint32 const* flags)
+{
+    if (flags == UnitUpdateFieldFlags)
+        return UnitUpdateFieldFlagMasks;
+    if (flags == ItemUpdateFieldFlags)
+        return ItemUpdateFieldFlagMasks;
+    if (flags == GameObjectUpdateFieldFlags)
+        return GameObjectUpdateFieldFlagMasks;
+    if (flags == DynamicObjectUpdateFieldFlags)
+        return DynamicObjectUpdateFieldFlagMasks;
+    if (flags == CorpseUpdateFieldFlags)
+        return CorpseUpdateFieldFlagMasks;
+    if (flags == AreaTriggerUpdateFieldFlags)
+        return AreaTriggerUpdateFieldFlagMasks;
+    if (flags == SceneObjectUpdateFieldFlags)
+        return SceneObjectUpdateFieldFlagMasks;
+
+    ASSERT(flags == ConversationUpdateFieldFlags);
+    return ConversationUpdateFieldFlagMasks;
+}
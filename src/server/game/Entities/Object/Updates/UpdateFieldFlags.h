@@ -20,6 +20,7 @@
 
 #include "UpdateFields.h"
 #include "Define.h"
+#include <vector>
 
 enum UpdatefieldFlags
 {
@@ -49,4 +50,30 @@ extern uint32 SceneObjectUpdateFieldFlags[SCENEOBJECT_END];
 extern uint32 ConversationUpdateFieldFlags[CONVERSATION_END];
 extern uint32 ConversationDynamicUpdateFieldFlags[CONVERSATION_DYNAMIC_END];
 
+/// Update field flag tables transposed into update mask sized bit blocks, one set per flag bit,
+/// so visibility of 32 fields at a time can be tested against a changes mask block.
+class UpdateFieldFlagMasks
+{
+    public:
+        UpdateFieldFlagMasks(uint32 const* flags, uint32 count);
+
+        /// Bits of fields in block that have any of flagMask flags
+        uint32 GetBlock(uint32 block, uint32 flagMask) const
+        {
+            uint32 bits = 0;
+            for (uint32 i = 0; i < MAX_FLAG_BITS; ++i)
+                if (flagMask & (1 << i))
+                    bits |= _blocks[i][block];
+
+            return bits;
+        }
+
+    private:
+        enum { MAX_FLAG_BITS = 11 };
+
+        std::vector<uint32> _blocks[MAX_FLAG_BITS];
+};
+
+UpdateFieldFlagMasks const& GetUpdateFieldFlagMasks(uint32 const* flags);
+
 #endif // _UPDATEFIELDFLAGS_H
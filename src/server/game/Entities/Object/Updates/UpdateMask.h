@@ -23,6 +23,13 @@
 #include "Errors.h"
 #include "ByteBuffer.h"
 
+#if COMPILER == COMPILER_MICROSOFT
+#  include <intrin.h>
+#endif
+
+/// Packed bit per update field, laid out exactly like the client update mask.
+/// A second, much smaller, bit array marks blocks that may have bits set so that
+/// clearing and walking a mask of a Player (thousands of fields) only touches dirty blocks.
 class UpdateMask
 {
     public:
@@ -34,31 +41,56 @@ class UpdateMask
             CLIENT_UPDATE_MASK_BITS = sizeof(ClientUpdateMaskType) * 8,
         };
 
-        UpdateMask() : _fieldCount(0), _blockCount(0), _bits(NULL) { }
+        UpdateMask() : _fieldCount(0), _blockCount(0), _bits(NULL), _dirtyBlocks(NULL) { }
 
-        UpdateMask(UpdateMask const& right) : _bits(NULL)
+        UpdateMask(UpdateMask const& right) : _fieldCount(0), _blockCount(0), _bits(NULL), _dirtyBlocks(NULL)
         {
-            SetCount(right.GetCount());
-            memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * 32);
+            *this = right;
         }
 
         ~UpdateMask() { delete[] _bits; }
 
-        void SetBit(uint32 index) { _bits[index] = 1; }
-        void UnsetBit(uint32 index) { _bits[index] = 0; }
-        bool GetBit(uint32 index) const { return _bits[index] != 0; }
+        void SetBit(uint32 index)
+        {
+            _bits[index / CLIENT_UPDATE_MASK_BITS] |= ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS);
+            MarkDirty(index / CLIENT_UPDATE_MASK_BITS);
+        }
+
+        void UnsetBit(uint32 index) { _bits[index / CLIENT_UPDATE_MASK_BITS] &= ~(ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS)); }
+        bool GetBit(uint32 index) const { return (_bits[index / CLIENT_UPDATE_MASK_BITS] & (ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS))) != 0; }
 
-        void AppendToPacket(ByteBuffer* data)
+        ClientUpdateMaskType GetBlock(uint32 block) const { return _bits[block]; }
+        void SetBlock(uint32 block, ClientUpdateMaskType bits)
         {
-            for (uint32 i = 0; i < GetBlockCount(); ++i)
+            _bits[block] = bits;
+            if (bits)
+                MarkDirty(block);
+        }
+
+        /// Returns the first set bit at or after index, GetCount() if there is none
+        uint32 FindNextSetBit(uint32 index) const
+        {
+            if (index >= _fieldCount)
+                return _fieldCount;
+
+            uint32 block = index / CLIENT_UPDATE_MASK_BITS;
+            ClientUpdateMaskType bits = _bits[block] & (~ClientUpdateMaskType(0) << (index % CLIENT_UPDATE_MASK_BITS));
+            while (!bits)
             {
-                ClientUpdateMaskType maskPart = 0;
-                for (uint32 j = 0; j < CLIENT_UPDATE_MASK_BITS; ++j)
-                    if (_bits[CLIENT_UPDATE_MASK_BITS * i + j])
-                        maskPart |= 1 << j;
+                block = FindNextDirtyBlock(block + 1);
+                if (block >= _blockCount)
+                    return _fieldCount;
 
-                *data << maskPart;
+                bits = _bits[block];
             }
+
+            return block * CLIENT_UPDATE_MASK_BITS + CountTrailingZeros(bits);
+        }
+
+        void AppendToPacket(ByteBuffer* data)
+        {
+            for (uint32 i = 0; i < GetBlockCount(); ++i)
+                *data << _bits[i];
         }
 
         uint32 GetBlockCount() const { return _blockCount; }
@@ -74,32 +106,42 @@ class UpdateMask
             if (!valuesCount)
             {
                 _bits = nullptr;
+                _dirtyBlocks = nullptr;
                 return;
             }
 
-            _bits = new uint8[_blockCount * CLIENT_UPDATE_MASK_BITS];
-            memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+            _bits = new ClientUpdateMaskType[_blockCount + GetDirtyBlockCount()];
+            _dirtyBlocks = _bits + _blockCount;
+            memset(_bits, 0, sizeof(ClientUpdateMaskType) * (_blockCount + GetDirtyBlockCount()));
         }
 
         void AddBlock()
         {
-            uint8* curr = _bits;
+            ClientUpdateMaskType* curr = _bits;
+            uint32 oldDirtyBlockCount = GetDirtyBlockCount();
             _fieldCount += CLIENT_UPDATE_MASK_BITS;
             ++_blockCount;
 
-            _bits = new uint8[_blockCount * CLIENT_UPDATE_MASK_BITS];
-            memset(&_bits[(_blockCount - 1) * CLIENT_UPDATE_MASK_BITS], 0, CLIENT_UPDATE_MASK_BITS);
+            _bits = new ClientUpdateMaskType[_blockCount + GetDirtyBlockCount()];
+            _dirtyBlocks = _bits + _blockCount;
+            memset(_bits, 0, sizeof(ClientUpdateMaskType) * (_blockCount + GetDirtyBlockCount()));
             if (curr)
             {
-                memcpy(_bits, curr, sizeof(uint8) * (_blockCount - 1) * CLIENT_UPDATE_MASK_BITS);
+                memcpy(_bits, curr, sizeof(ClientUpdateMaskType) * (_blockCount - 1));
+                memcpy(_dirtyBlocks, curr + _blockCount - 1, sizeof(ClientUpdateMaskType) * oldDirtyBlockCount);
                 delete[] curr;
             }
         }
 
         void Clear()
         {
-            if (_bits)
-                memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+            for (uint32 i = 0; i < GetDirtyBlockCount(); ++i)
+            {
+                for (ClientUpdateMaskType dirty = _dirtyBlocks[i]; dirty; dirty &= dirty - 1)
+                    _bits[i * CLIENT_UPDATE_MASK_BITS + CountTrailingZeros(dirty)] = 0;
+
+                _dirtyBlocks[i] = 0;
+            }
         }
 
         UpdateMask& operator=(UpdateMask const& right)
@@ -108,15 +150,16 @@ class UpdateMask
                 return *this;
 
             SetCount(right.GetCount());
-            memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+            if (_bits)
+                memcpy(_bits, right._bits, sizeof(ClientUpdateMaskType) * (_blockCount + GetDirtyBlockCount()));
             return *this;
         }
 
         UpdateMask& operator&=(UpdateMask const& right)
         {
             ASSERT(right.GetCount() <= GetCount());
-            for (uint32 i = 0; i < _fieldCount; ++i)
-                _bits[i] &= right._bits[i];
+            for (uint32 i = 0; i < _blockCount; ++i)
+                _bits[i] &= i < right._blockCount ? right._bits[i] : 0;
 
             return *this;
         }
@@ -124,8 +167,8 @@ class UpdateMask
         UpdateMask& operator|=(UpdateMask const& right)
         {
             ASSERT(right.GetCount() <= GetCount());
-            for (uint32 i = 0; i < _fieldCount; ++i)
-                _bits[i] |= right._bits[i];
+            for (uint32 i = 0; i < right._blockCount; ++i)
+                SetBlock(i, _bits[i] | right._bits[i]);
 
             return *this;
         }
@@ -137,11 +180,43 @@ class UpdateMask
             return ret;
         }
 
+        static uint32 CountTrailingZeros(ClientUpdateMaskType bits)
+        {
+#if COMPILER == COMPILER_MICROSOFT
+            unsigned long index;
+            _BitScanForward(&index, bits);
+            return index;
+#else
+            return __builtin_ctz(bits);
+#endif
+        }
+
     private:
+        uint32 GetDirtyBlockCount() const { return (_blockCount + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS; }
+        void MarkDirty(uint32 block) { _dirtyBlocks[block / CLIENT_UPDATE_MASK_BITS] |= ClientUpdateMaskType(1) << (block % CLIENT_UPDATE_MASK_BITS); }
+
+        uint32 FindNextDirtyBlock(uint32 block) const
+        {
+            uint32 i = block / CLIENT_UPDATE_MASK_BITS;
+            if (i >= GetDirtyBlockCount())
+                return _blockCount;
+
+            ClientUpdateMaskType dirty = _dirtyBlocks[i] & (~ClientUpdateMaskType(0) << (block % CLIENT_UPDATE_MASK_BITS));
+            while (!dirty)
+            {
+                if (++i >= GetDirtyBlockCount())
+                    return _blockCount;
+
+                dirty = _dirtyBlocks[i];
+            }
+
+            return i * CLIENT_UPDATE_MASK_BITS + CountTrailingZeros(dirty);
+        }
+
         uint32 _fieldCount;
         uint32 _blockCount;
-        uint8* _bits;
+        ClientUpdateMaskType* _bits;
+        ClientUpdateMaskType* _dirtyBlocks;                 // bit per block of _bits that may be non zero, same allocation
 };
 
 #endif
-
@@ -59,6 +59,7 @@
 #include "UpdateFieldFlags.h"
 #include "Util.h"
 #include "Vehicle.h"
+#include "WhoListStorage.h"
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
@@ -192,7 +193,7 @@ Unit::Unit(bool isWorldObject) :
     IsAIEnabled(false), NeedChangeAI(false), LastCharmerGUID(),
     m_ControlledByPlayer(false), movespline(new Movement::MoveSpline()),
     i_AI(NULL), i_disabledAI(NULL), m_AutoRepeatFirstCast(false), m_procDeep(0),
-    m_removedAurasCount(0), i_motionMaster(new MotionMaster(this)), m_regenTimer(0), m_ThreatManager(this),
+    m_removedAurasCount(0), m_auraUpdateClock(0), m_auraTypeTotalsVersion(0), m_procAurasFlags(0), m_procAurasVersion(0), i_motionMaster(new MotionMaster(this)), m_regenTimer(0), m_ThreatManager(this),
     m_vehicle(NULL), m_vehicleKit(NULL), m_unitTypeMask(UNIT_MASK_NONE),
     m_HostileRefManager(this), _lastDamagedTime(0), _spellHistory(new SpellHistory(this))
 {
@@ -1604,7 +1605,7 @@ void Unit::CalcAbsorbResist(Unit* victim, SpellSchoolMask schoolMask, DamageEffe
     // We're going to call functions which can modify content of the list during iteration over it's elements
     // Let's copy the list so we can prevent iterator invalidation
     AuraEffectList vSchoolAbsorbCopy(victim->GetAuraEffectsByType(SPELL_AURA_SCHOOL_ABSORB));
-    vSchoolAbsorbCopy.sort(Trinity::AbsorbAuraOrderPred());
+    std::stable_sort(vSchoolAbsorbCopy.begin(), vSchoolAbsorbCopy.end(), Trinity::AbsorbAuraOrderPred());
 
     // absorb without mana cost
     for (AuraEffectList::iterator itr = vSchoolAbsorbCopy.begin(); (itr != vSchoolAbsorbCopy.end()) && (dmgInfo.GetDamage() > 0); ++itr)
@@ -1804,17 +1805,17 @@ void Unit::CalcHealAbsorb(Unit* victim, SpellInfo const* healSpell, uint32 &heal
     // Remove all expired absorb auras
     if (existExpired)
     {
-        for (AuraEffectList::const_iterator i = vHealAbsorb.begin(); i != vHealAbsorb.end();)
+        // removal handlers can remove or apply other auras, iterate a copy
+        AuraEffectList vHealAbsorbCopy(vHealAbsorb);
+        for (AuraEffectList::iterator i = vHealAbsorbCopy.begin(); i != vHealAbsorbCopy.end(); ++i)
         {
             AuraEffect* auraEff = *i;
-            ++i;
+            // Check if aura was removed during iteration
+            if (!auraEff->GetBase()->GetApplicationOfTarget(victim->GetGUID()))
+                continue;
+
             if (auraEff->GetAmount() <= 0)
-            {
-                uint32 removedAuras = victim->m_removedAurasCount;
                 auraEff->GetBase()->Remove(AURA_REMOVE_BY_ENEMY_SPELL);
-                if (removedAuras+1 < victim->m_removedAurasCount)
-                    i = vHealAbsorb.begin();
-            }
         }
     }
 
@@ -2644,14 +2645,30 @@ void Unit::_UpdateSpells(uint32 time)
         }
     }
 
+    m_auraUpdateClock += time;
+    uint32 updatedAuras = 0;
+    uint32 skippedAuras = 0;
+
     // m_auraUpdateIterator can be updated in indirect called code at aura remove to skip next planned to update but removed auras
     for (m_auraUpdateIterator = m_ownedAuras.begin(); m_auraUpdateIterator != m_ownedAuras.end();)
     {
         Aura* i_aura = m_auraUpdateIterator->second;
         ++m_auraUpdateIterator;                            // need shift to next for allow update if need into aura update
-        i_aura->UpdateOwner(time, this);
+
+        // auras without periodic work have nothing to do until their duration or target map timer runs out
+        if (i_aura->IsSleeping() && !i_aura->IsWakeUpDue(m_auraUpdateClock))
+        {
+            ++skippedAuras;
+            continue;
+        }
+
+        i_aura->UpdateOwner(i_aura->PrepareOwnerUpdate(m_auraUpdateClock), this);
+        i_aura->TrySleep();
+        ++updatedAuras;
     }
 
+    Aura::RecordOwnerUpdates(updatedAuras, skippedAuras);
+
     // remove expired auras - do that after updates(used in scripts?)
     for (AuraMap::iterator i = m_ownedAuras.begin(); i != m_ownedAuras.end();)
     {
@@ -3099,6 +3116,7 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
 
     AuraApplication * aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
+    _AddProcAura(aurApp);
 
     if (aurSpellInfo->AuraInterruptFlags)
     {
@@ -3184,6 +3202,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
+    _RemoveProcAura(aurApp);
 
     if (aura->GetSpellInfo()->AuraInterruptFlags)
     {
@@ -3305,10 +3324,50 @@ void Unit::_RemoveNoStackAurasDueToAura(Aura* aura)
 
 void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
 {
+    AuraEffectList& effects = m_modAuras[aurEff->GetAuraType()];
     if (apply)
-        m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
+        effects.push_back(aurEff);
     else
-        m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+    {
+        // keep application order, some handlers depend on the first/last applied effect
+        AuraEffectList::iterator itr = std::find(effects.begin(), effects.end(), aurEff);
+        if (itr != effects.end())
+            effects.erase(itr);
+    }
+
+    InvalidateAuraTypeTotals(aurEff->GetAuraType());
+}
+
+namespace
+{
+    struct AuraTypeTotalsOrderPred
+    {
+        template<class T>
+        bool operator()(T const& totals, AuraType auraType) const { return totals.Type < auraType; }
+    };
+}
+
+void Unit::InvalidateAuraTypeTotals(AuraType auraType)
+{
+    std::vector<AuraTypeTotals>::iterator itr = std::lower_bound(m_auraTypeTotals.begin(), m_auraTypeTotals.end(), auraType, AuraTypeTotalsOrderPred());
+    if (itr != m_auraTypeTotals.end() && itr->Type == auraType)
+        m_auraTypeTotals.erase(itr);
+}
+
+Unit::AuraTypeTotals& Unit::GetAuraTypeTotals(AuraType auraType) const
+{
+    // totals depend on spell group stacking rules, which can be reloaded
+    if (m_auraTypeTotalsVersion != sSpellMgr->GetSpellGroupDataVersion())
+    {
+        m_auraTypeTotals.clear();
+        m_auraTypeTotalsVersion = sSpellMgr->GetSpellGroupDataVersion();
+    }
+
+    std::vector<AuraTypeTotals>::iterator itr = std::lower_bound(m_auraTypeTotals.begin(), m_auraTypeTotals.end(), auraType, AuraTypeTotalsOrderPred());
+    if (itr == m_auraTypeTotals.end() || itr->Type != auraType)
+        itr = m_auraTypeTotals.insert(itr, AuraTypeTotals(auraType));
+
+    return *itr;
 }
 
 // All aura base removes should go threw this function!
@@ -3516,20 +3575,17 @@ void Unit::RemoveOwnedAuras(uint32 spellId, std::function<bool(Aura const*)> con
 
 void Unit::RemoveAurasByType(AuraType auraType, std::function<bool(AuraApplication const*)> const& check)
 {
-    for (AuraEffectList::iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    // removal handlers can remove or apply other auras, iterate a copy
+    AuraEffectList effects(m_modAuras[auraType]);
+    for (AuraEffectList::iterator itr = effects.begin(); itr != effects.end(); ++itr)
     {
-        Aura* aura = (*iter)->GetBase();
-        AuraApplication * aurApp = aura->GetApplicationOfTarget(GetGUID());
-        ASSERT(aurApp);
+        // Check if aura was removed during iteration
+        AuraApplication * aurApp = (*itr)->GetBase()->GetApplicationOfTarget(GetGUID());
+        if (!aurApp)
+            continue;
 
-        ++iter;
         if (check(aurApp))
-        {
-            uint32 removedAuras = m_removedAurasCount;
             RemoveAura(aurApp);
-            if (m_removedAurasCount > removedAuras + 1)
-                iter = m_modAuras[auraType].begin();
-        }
     }
 }
 
@@ -3686,21 +3742,19 @@ void Unit::RemoveAurasDueToItemSpell(uint32 spellId, ObjectGuid castItemGuid)
 
 void Unit::RemoveAurasByType(AuraType auraType, ObjectGuid casterGUID, Aura* except, bool negative, bool positive)
 {
-    for (AuraEffectList::iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    // removal handlers can remove or apply other auras, iterate a copy
+    AuraEffectList effects(m_modAuras[auraType]);
+    for (AuraEffectList::iterator itr = effects.begin(); itr != effects.end(); ++itr)
     {
-        Aura* aura = (*iter)->GetBase();
+        Aura* aura = (*itr)->GetBase();
+        // Check if aura was removed during iteration
         AuraApplication * aurApp = aura->GetApplicationOfTarget(GetGUID());
-        ASSERT(aurApp);
+        if (!aurApp)
+            continue;
 
-        ++iter;
         if (aura != except && (!casterGUID || aura->GetCasterGUID() == casterGUID)
             && ((negative && !aurApp->IsPositive()) || (positive && aurApp->IsPositive())))
-        {
-            uint32 removedAuras = m_removedAurasCount;
             RemoveAura(aurApp);
-            if (m_removedAurasCount > removedAuras + 1)
-                iter = m_modAuras[auraType].begin();
-        }
     }
 }
 
@@ -4342,6 +4396,10 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype) const
     if (mTotalAuraList.empty())
         return 0;
 
+    AuraTypeTotals& totals = GetAuraTypeTotals(auratype);
+    if (totals.ValidMask & AURA_TOTAL_MODIFIER)
+        return totals.Modifier;
+
     std::map<SpellGroup, int32> SameEffectSpellGroup;
     int32 modifier = 0;
 
@@ -4352,6 +4410,8 @@ int32 Unit::GetTotalAuraModifier(AuraType auratype) const
     for (std::map<SpellGroup, int32>::const_iterator itr = SameEffectSpellGroup.begin(); itr != SameEffectSpellGroup.end(); ++itr)
         modifier += itr->second;
 
+    totals.Modifier = modifier;
+    totals.ValidMask |= AURA_TOTAL_MODIFIER;
     return modifier;
 }
 
@@ -4360,9 +4420,18 @@ float Unit::GetTotalAuraMultiplier(AuraType auratype) const
     float multiplier = 1.0f;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return multiplier;
+
+    AuraTypeTotals& totals = GetAuraTypeTotals(auratype);
+    if (totals.ValidMask & AURA_TOTAL_MULTIPLIER)
+        return totals.Multiplier;
+
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         AddPct(multiplier, (*i)->GetAmount());
 
+    totals.Multiplier = multiplier;
+    totals.ValidMask |= AURA_TOTAL_MULTIPLIER;
     return multiplier;
 }
 
@@ -4371,12 +4440,21 @@ int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return modifier;
+
+    AuraTypeTotals& totals = GetAuraTypeTotals(auratype);
+    if (totals.ValidMask & AURA_TOTAL_MAX_POSITIVE)
+        return totals.MaxPositive;
+
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
     {
         if ((*i)->GetAmount() > modifier)
             modifier = (*i)->GetAmount();
     }
 
+    totals.MaxPositive = modifier;
+    totals.ValidMask |= AURA_TOTAL_MAX_POSITIVE;
     return modifier;
 }
 
@@ -4385,10 +4463,19 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
+    if (mTotalAuraList.empty())
+        return modifier;
+
+    AuraTypeTotals& totals = GetAuraTypeTotals(auratype);
+    if (totals.ValidMask & AURA_TOTAL_MAX_NEGATIVE)
+        return totals.MaxNegative;
+
     for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
         if ((*i)->GetAmount() < modifier)
             modifier = (*i)->GetAmount();
 
+    totals.MaxNegative = modifier;
+    totals.ValidMask |= AURA_TOTAL_MAX_NEGATIVE;
     return modifier;
 }
 
@@ -7508,7 +7595,7 @@ Unit* Unit::GetOwner() const
 {
     ObjectGuid ownerGUID = GetOwnerGUID();
     if (!ownerGUID.IsEmpty())
-        return ObjectAccessor::GetUnit(*this, ownerGUID);
+        return ObjectAccessor::GetUnit(*this, ownerGUID, m_ownerHandle);
 
     return NULL;
 }
@@ -7517,7 +7604,7 @@ Unit* Unit::GetCharmer() const
 {
     ObjectGuid charmerGUID = GetCharmerGUID();
     if (!charmerGUID.IsEmpty())
-        return ObjectAccessor::GetUnit(*this, charmerGUID);
+        return ObjectAccessor::GetUnit(*this, charmerGUID, m_charmerHandle);
 
     return NULL;
 }
@@ -11439,6 +11526,7 @@ void Unit::SetLevel(uint8 lvl)
             player->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
 
         sWorld->UpdateCharacterInfoLevel(GetGUID(), lvl);
+        sWhoListStorage->UpdateLevel(GetGUID(), lvl);
     }
 }
 
@@ -12016,6 +12104,8 @@ bool Unit::isFrozen() const
     return HasAuraState(AURA_STATE_FROZEN);
 }
 
+ProcAuraStatistics Unit::_procAuraStatistics;
+
 struct ProcTriggeredData
 {
     ProcTriggeredData(Aura* _aura)
@@ -12201,25 +12291,36 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     HealInfo healInfo = HealInfo(damage);
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, 0, procExtra, NULL, &damageInfo, &healInfo);
 
+    if (m_procAurasVersion != sSpellMgr->GetProcDataVersion())
+        _RebuildProcAuras();
+
+    if (isVictim)
+        procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+
     ProcTriggeredList procTriggered;
-    // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr!= GetAppliedAuras().end(); ++itr)
+    uint32 evaluated = 0;
+    // Fill procTriggered list, only auras with matching proc flags can pass IsTriggeredAtSpellProcEvent
+    for (size_t i = 0; (m_procAurasFlags & procFlag) && i < m_procAuras.size(); ++i)
     {
+        if (!(m_procAuras[i].ProcFlags & procFlag))
+            continue;
+
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == m_procAuras[i].SpellId)
             continue;
-        ProcTriggeredData triggerData(itr->second->GetBase());
+
+        AuraApplication* aurApp = m_procAuras[i].AurApp;
+        ProcTriggeredData triggerData(aurApp->GetBase());
+        ++evaluated;
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
-        if (isVictim)
-            procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
 
         // only auras that has triggered spell should proc from fully absorbed damage
         if (procExtra & PROC_EX_ABSORB && isVictim && damage)
         {
-            for (SpellEffectInfo const* effect : itr->second->GetBase()->GetSpellEffectInfos())
+            for (SpellEffectInfo const* effect : aurApp->GetBase()->GetSpellEffectInfos())
             {
                 if (effect && effect->TriggerSpell)
                 {
@@ -12232,20 +12333,20 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             continue;
 
         // do checks using conditions table
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, spellProto->Id);
+        ConditionSpan conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, spellProto->Id);
         ConditionSourceInfo condInfo = ConditionSourceInfo(eventInfo.GetActor(), eventInfo.GetActionTarget());
         if (!sConditionMgr->IsObjectMeetToConditions(condInfo, conditions))
             continue;
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptCheckProcHandlers(itr->second, eventInfo))
+        if (!triggerData.aura->CallScriptCheckProcHandlers(aurApp, eventInfo))
             continue;
 
         // Triggered spells not triggering additional spells
         bool triggered = !spellProto->HasAttribute(SPELL_ATTR3_CAN_PROC_WITH_TRIGGERED) ?
             (procExtra & PROC_EX_INTERNAL_TRIGGERED && !(procFlag & PROC_FLAG_DONE_TRAP_ACTIVATION)) : false;
 
-        for (AuraEffect const* aurEff : itr->second->GetBase()->GetAuraEffects())
+        for (AuraEffect const* aurEff : aurApp->GetBase()->GetAuraEffects())
         {
             if (aurEff)
             {
@@ -12264,6 +12365,12 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             procTriggered.push_front(triggerData);
     }
 
+    ++_procAuraStatistics.Events;
+    if (evaluated)
+        _procAuraStatistics.Evaluated += evaluated;
+    if (m_appliedAuras.size() > evaluated)
+        _procAuraStatistics.Skipped += m_appliedAuras.size() - evaluated;
+
     // Nothing found
     if (procTriggered.empty())
         return;
@@ -13164,6 +13271,52 @@ bool Unit::InitTamedPet(Pet* pet, uint8 level, uint32 spell_id)
     return true;
 }
 
+void Unit::_AddProcAura(AuraApplication* aurApp)
+{
+    SpellInfo const* spellInfo = aurApp->GetBase()->GetSpellInfo();
+    uint32 procFlags = sSpellMgr->GetSpellProcEventFlags(spellInfo);
+    if (!procFlags)
+        return;
+
+    // same position as in m_appliedAuras - after all applications of the same spell
+    std::vector<ProcAuraEntry>::iterator itr = m_procAuras.begin();
+    while (itr != m_procAuras.end() && itr->SpellId <= spellInfo->Id)
+        ++itr;
+
+    ProcAuraEntry entry;
+    entry.SpellId = spellInfo->Id;
+    entry.ProcFlags = procFlags;
+    entry.AurApp = aurApp;
+    m_procAuras.insert(itr, entry);
+    m_procAurasFlags |= procFlags;
+}
+
+void Unit::_RemoveProcAura(AuraApplication* aurApp)
+{
+    for (std::vector<ProcAuraEntry>::iterator itr = m_procAuras.begin(); itr != m_procAuras.end(); ++itr)
+    {
+        if (itr->AurApp != aurApp)
+            continue;
+
+        m_procAuras.erase(itr);
+
+        m_procAurasFlags = 0;
+        for (ProcAuraEntry const& entry : m_procAuras)
+            m_procAurasFlags |= entry.ProcFlags;
+        break;
+    }
+}
+
+void Unit::_RebuildProcAuras()
+{
+    m_procAuras.clear();
+    m_procAurasFlags = 0;
+    m_procAurasVersion = sSpellMgr->GetProcDataVersion();
+
+    for (AuraApplicationMap::const_iterator itr = m_appliedAuras.begin(); itr != m_appliedAuras.end(); ++itr)
+        _AddProcAura(itr->second);
+}
+
 bool Unit::IsTriggeredAtSpellProcEvent(Unit* victim, Aura* aura, SpellInfo const* procSpell, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, bool isVictim, bool active, SpellProcEventEntry const* & spellProcEvent)
 {
     SpellInfo const* spellProto = aura->GetSpellInfo();
@@ -14533,15 +14686,12 @@ bool Unit::SetInPhase(uint32 id, bool update, bool apply)
         // modify threat lists for new phasemask
         if (GetTypeId() != TYPEID_PLAYER)
         {
-            std::list<HostileReference*> threatList = getThreatManager().getThreatList();
-            std::list<HostileReference*> offlineThreatList = getThreatManager().getOfflineThreatList();
+            // copy, references move between the lists below
+            ThreatContainer::StorageType threatList = getThreatManager().getThreatList();
+            ThreatContainer::StorageType const& offlineThreatList = getThreatManager().getOfflineThreatList();
+            threatList.insert(threatList.end(), offlineThreatList.begin(), offlineThreatList.end());
 
-            // merge expects sorted lists
-            threatList.sort();
-            offlineThreatList.sort();
-            threatList.merge(offlineThreatList);
-
-            for (std::list<HostileReference*>::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
+            for (ThreatContainer::StorageType::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
                 if (Unit* unit = (*itr)->getTarget())
                     unit->getHostileRefManager().setOnlineOfflineState(ToCreature(), unit->IsInPhase(this));
         }
@@ -15131,7 +15281,7 @@ bool Unit::HandleSpellClick(Unit* clicker, int8 seatId)
             continue;
 
         //! Check database conditions
-        ConditionList conds = sConditionMgr->GetConditionsForSpellClickEvent(spellClickEntry, itr->second.spellId);
+        ConditionSpan conds = sConditionMgr->GetConditionsForSpellClickEvent(spellClickEntry, itr->second.spellId);
         ConditionSourceInfo info = ConditionSourceInfo(clicker, this);
         if (!sConditionMgr->IsObjectMeetToConditions(info, conds))
             continue;
@@ -16110,145 +16260,144 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     if (plr && plr->IsInSameRaidWith(target))
         visibleFlag |= UF_FLAG_PARTY_MEMBER;
 
+    UpdateFieldFlagMasks const& flagMasks = GetUpdateFieldFlagMasks(flags);
+    for (uint32 block = 0; block < updateMask.GetBlockCount(); ++block)
+        updateMask.SetBlock(block, GetUpdateFieldBlock(updateType, block, valCount, flagMasks, visibleFlag, visibleFlag & UF_FLAG_SPECIAL_INFO));
+
+    if (HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK))
+        updateMask.SetBit(UNIT_FIELD_AURASTATE);
+
     Creature const* creature = ToCreature();
-    for (uint16 index = 0; index < valCount; ++index)
+    for (uint32 index = updateMask.FindNextSetBit(0); index < valCount; index = updateMask.FindNextSetBit(index + 1))
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-            (index == UNIT_FIELD_AURASTATE && HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK)))
+        if (index == UNIT_NPC_FLAGS)
         {
-            updateMask.SetBit(index);
+            uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
 
-            if (index == UNIT_NPC_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
+            if (creature)
+                if (!target->CanSeeSpellClickOn(creature))
+                    appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
 
-                if (creature)
-                    if (!target->CanSeeSpellClickOn(creature))
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+            fieldBuffer << uint32(appendValue);
+        }
+        else if (index == UNIT_FIELD_AURASTATE)
+        {
+            // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+            fieldBuffer << BuildAuraStateUpdateForTarget(target);
+        }
+        // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+        else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+        {
+            // convert from float to uint32 and send
+            fieldBuffer << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+        }
+        // there are some float values which may be negative or can't get negative due to other checks
+        else if ((index >= UNIT_FIELD_NEGSTAT && index < UNIT_FIELD_NEGSTAT + 5) ||
+            (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+            (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+            (index >= UNIT_FIELD_POSSTAT && index < UNIT_FIELD_POSSTAT + 5))
+        {
+            fieldBuffer << uint32(m_floatValues[index]);
+        }
+        // Gamemasters should be always able to select units - remove not selectable flag
+        else if (index == UNIT_FIELD_FLAGS)
+        {
+            uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
+            if (target->IsGameMaster())
+                appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
 
-                fieldBuffer << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURASTATE)
-            {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                fieldBuffer << BuildAuraStateUpdateForTarget(target);
-            }
-            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-            {
-                // convert from float to uint32 and send
-                fieldBuffer << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-            }
-            // there are some float values which may be negative or can't get negative due to other checks
-            else if ((index >= UNIT_FIELD_NEGSTAT && index < UNIT_FIELD_NEGSTAT + 5) ||
-                (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                (index >= UNIT_FIELD_POSSTAT && index < UNIT_FIELD_POSSTAT + 5))
-            {
-                fieldBuffer << uint32(m_floatValues[index]);
-            }
-            // Gamemasters should be always able to select units - remove not selectable flag
-            else if (index == UNIT_FIELD_FLAGS)
+            fieldBuffer << uint32(appendValue);
+        }
+        // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+        else if (index == UNIT_FIELD_DISPLAYID)
+        {
+            uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
+            if (creature)
             {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-                if (target->IsGameMaster())
-                    appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
+                CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
 
-                fieldBuffer << uint32(appendValue);
-            }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAYID)
-            {
-                uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
-                if (creature)
-                {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
-
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
-                        for (SpellEffectInfo const* effect : transform->GetEffectsForDifficulty(GetMap()->GetDifficultyID()))
-                            if (effect && effect->IsAura(SPELL_AURA_TRANSFORM))
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(effect->MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
+                // this also applies for transform auras
+                if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
+                    for (SpellEffectInfo const* effect : transform->GetEffectsForDifficulty(GetMap()->GetDifficultyID()))
+                        if (effect && effect->IsAura(SPELL_AURA_TRANSFORM))
+                            if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(effect->MiscValue))
+                            {
+                                cinfo = transformInfo;
+                                break;
+                            }
 
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
+                {
+                    if (target->IsGameMaster())
                     {
-                        if (target->IsGameMaster())
-                        {
-                            if (cinfo->Modelid1)
-                                displayId = cinfo->Modelid1;    // Modelid1 is a visible model for gms
-                            else
-                                displayId = 17519;              // world visible trigger's model
-                        }
+                        if (cinfo->Modelid1)
+                            displayId = cinfo->Modelid1;    // Modelid1 is a visible model for gms
                         else
-                        {
-                            if (cinfo->Modelid2)
-                                displayId = cinfo->Modelid2;    // Modelid2 is an invisible model for players
-                            else
-                                displayId = 11686;              // world invisible trigger's model
-                        }
+                            displayId = 17519;              // world visible trigger's model
+                    }
+                    else
+                    {
+                        if (cinfo->Modelid2)
+                            displayId = cinfo->Modelid2;    // Modelid2 is an invisible model for players
+                        else
+                            displayId = 11686;              // world invisible trigger's model
                     }
                 }
-
-                fieldBuffer << uint32(displayId);
             }
-            // hide lootable animation for unallowed players
-            else if (index == OBJECT_DYNAMIC_FLAGS)
-            {
-                uint32 dynamicFlags = m_uint32Values[OBJECT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-                if (creature)
-                {
-                    if (creature->hasLootRecipient())
-                    {
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                        if (creature->isTappedBy(target))
-                            dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                    }
+            fieldBuffer << uint32(displayId);
+        }
+        // hide lootable animation for unallowed players
+        else if (index == OBJECT_DYNAMIC_FLAGS)
+        {
+            uint32 dynamicFlags = m_uint32Values[OBJECT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
 
-                    if (!target->isAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+            if (creature)
+            {
+                if (creature->hasLootRecipient())
+                {
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                    if (creature->isTappedBy(target))
+                        dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                 }
 
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
-
-                fieldBuffer << dynamicFlags;
+                if (!target->isAllowedToLoot(creature))
+                    dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
             }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+
+            // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+            if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+                if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                    dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+            fieldBuffer << dynamicFlags;
+        }
+        // FG: pretend that OTHER players in own group are friendly ("blue")
+        else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+        {
+            if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
             {
-                if (IsControlledByPlayer() && target != this && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && IsInRaidWith(target))
+                FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
+                FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
+                if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
                 {
-                    FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-                    if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
-                    {
-                        if (index == UNIT_FIELD_BYTES_2)
-                            // Allow targetting opposite faction in party when enabled in config
-                            fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
-                        else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            fieldBuffer << uint32(target->getFaction());
-                    }
+                    if (index == UNIT_FIELD_BYTES_2)
+                        // Allow targetting opposite faction in party when enabled in config
+                        fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
                     else
-                        fieldBuffer << m_uint32Values[index];
+                        // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                        fieldBuffer << uint32(target->getFaction());
                 }
                 else
                     fieldBuffer << m_uint32Values[index];
             }
             else
-            {
-                // send in current format (float as float, uint32 as uint32)
                 fieldBuffer << m_uint32Values[index];
-            }
+        }
+        else
+        {
+            // send in current format (float as float, uint32 as uint32)
+            fieldBuffer << m_uint32Values[index];
         }
     }
 
@@ -16303,11 +16452,15 @@ bool Unit::IsHighestExclusiveAura(Aura const* aura, bool removeOtherAuraApplicat
         if (!aurEff)
             continue;
         AuraType const auraType = AuraType(aurEff->GetSpellEffectInfo()->ApplyAuraName);
-        AuraEffectList const& auras = GetAuraEffectsByType(auraType);
-        for (Unit::AuraEffectList::const_iterator itr = auras.begin(); itr != auras.end();)
+        // removal handlers can remove or apply other auras, iterate a copy
+        AuraEffectList auras(GetAuraEffectsByType(auraType));
+        for (AuraEffectList::const_iterator itr = auras.begin(); itr != auras.end(); ++itr)
         {
-            AuraEffect const* existingAurEff = (*itr);
-            ++itr;
+            AuraEffect const* existingAurEff = *itr;
+            // Check if aura was removed during iteration
+            AuraApplication* aurApp = existingAurEff->GetBase()->GetApplicationOfTarget(GetGUID());
+            if (!aurApp)
+                continue;
 
             if (sSpellMgr->CheckSpellGroupStackRules(aura->GetSpellInfo(), existingAurEff->GetSpellInfo())
                 == SPELL_GROUP_STACK_RULE_EXCLUSIVE_HIGHEST)
@@ -16321,16 +16474,7 @@ bool Unit::IsHighestExclusiveAura(Aura const* aura, bool removeOtherAuraApplicat
                     Aura const* base = existingAurEff->GetBase();
                     // no removing of area auras from the original owner, as that completely cancels them
                     if (removeOtherAuraApplications && (!base->IsArea() || base->GetOwner() != this))
-                    {
-                        if (AuraApplication* aurApp = existingAurEff->GetBase()->GetApplicationOfTarget(GetGUID()))
-                        {
-                            bool hasMoreThanOneEffect = base->HasMoreThanOneEffectForType(auraType);
-                            uint32 removedAuras = m_removedAurasCount;
-                            RemoveAura(aurApp);
-                            if (hasMoreThanOneEffect || m_removedAurasCount > removedAuras + 1)
-                                itr = auras.begin();
-                        }
-                    }
+                        RemoveAura(aurApp);
                 }
                 else if (diff < 0)
                     return false;
@@ -29,6 +29,7 @@
 #include "SpellAuraDefines.h"
 #include "ThreatManager.h"
 #include "MoveSplineInit.h"
+#include <atomic>
 
 #define WORLD_TRIGGER   12999
 
@@ -1295,6 +1296,14 @@ enum PlayerTotemType
 
 struct SpellProcEventEntry;                                 // used only privately
 
+// Counters of Unit::ProcDamageAndSpellFor work, shared by all maps
+struct ProcAuraStatistics
+{
+    std::atomic<uint64> Events;
+    std::atomic<uint64> Evaluated;                          // auras matching the event proc flags
+    std::atomic<uint64> Skipped;                            // applied auras not examined thanks to the proc index
+};
+
 class Unit : public WorldObject
 {
     public:
@@ -1312,7 +1321,7 @@ class Unit : public WorldObject
         typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
         typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-        typedef std::list<AuraEffect*> AuraEffectList;
+        typedef std::vector<AuraEffect*> AuraEffectList;
         typedef std::list<Aura*> AuraList;
         typedef std::list<AuraApplication *> AuraApplicationList;
         typedef std::list<DiminishingReturn> Diminishing;
@@ -1505,6 +1514,7 @@ class Unit : public WorldObject
 
         void ProcDamageAndSpell(Unit* victim, uint32 procAttacker, uint32 procVictim, uint32 procEx, uint32 amount, WeaponAttackType attType = BASE_ATTACK, SpellInfo const* procSpell = NULL, SpellInfo const* procAura = NULL);
         void ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, uint32 procExtra, WeaponAttackType attType, SpellInfo const* procSpell, uint32 damage, SpellInfo const* procAura = NULL);
+        static ProcAuraStatistics const& GetProcAuraStatistics() { return _procAuraStatistics; }
 
         void GetProcAurasTriggeredOnEvent(AuraApplicationList& aurasTriggeringProc, AuraApplicationList* procAuras, ProcEventInfo eventInfo);
         void TriggerAurasProcOnEvent(CalcDamageInfo& damageInfo);
@@ -1764,10 +1774,13 @@ class Unit : public WorldObject
         void _RemoveNoStackAurasDueToAura(Aura* aura);
         bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
         void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+        // must be called whenever the amount of an applied effect of this type changes
+        void InvalidateAuraTypeTotals(AuraType auraType);
 
         // m_ownedAuras container management
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
         AuraMap const& GetOwnedAuras() const { return m_ownedAuras; }
+        uint32 GetAuraUpdateClock() const { return m_auraUpdateClock; }
 
         void RemoveOwnedAura(AuraMap::iterator &i, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
         void RemoveOwnedAura(uint32 spellId, ObjectGuid casterGUID = ObjectGuid::Empty, uint32 reqEffMask = 0, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
@@ -2084,6 +2097,7 @@ class Unit : public WorldObject
 
         void addFollower(FollowerReference* pRef) { m_FollowingRefManager.insertFirst(pRef); }
         void removeFollower(FollowerReference* /*pRef*/) { /* nothing to do yet */ }
+        FollowerRefManager& GetFollowingRefManager() { return m_FollowingRefManager; }
 
         MotionMaster* GetMotionMaster() { return i_motionMaster; }
         const MotionMaster* GetMotionMaster() const { return i_motionMaster; }
@@ -2262,10 +2276,53 @@ class Unit : public WorldObject
         AuraList m_removedAuras;
         AuraMap::iterator m_auraUpdateIterator;
         uint32 m_removedAurasCount;
+        uint32 m_auraUpdateClock;                           // sum of _UpdateSpells diffs, used by sleeping owned auras
 
         AuraEffectList m_modAuras[TOTAL_AURAS];
+
+        // cached results of GetTotalAuraModifier, GetTotalAuraMultiplier, GetMaxPositiveAuraModifier and GetMaxNegativeAuraModifier
+        // only aura types present on the unit get an entry, sorted by type and dropped when effects of that type change
+        enum AuraTypeTotalsMask
+        {
+            AURA_TOTAL_MODIFIER     = 0x1,
+            AURA_TOTAL_MULTIPLIER   = 0x2,
+            AURA_TOTAL_MAX_POSITIVE = 0x4,
+            AURA_TOTAL_MAX_NEGATIVE = 0x8
+        };
+
+        struct AuraTypeTotals
+        {
+            explicit AuraTypeTotals(AuraType type) : Type(type), ValidMask(0), Modifier(0), Multiplier(1.0f), MaxPositive(0), MaxNegative(0) { }
+
+            AuraType Type;
+            uint32 ValidMask;
+            int32 Modifier;
+            float Multiplier;
+            int32 MaxPositive;
+            int32 MaxNegative;
+        };
+
+        AuraTypeTotals& GetAuraTypeTotals(AuraType auraType) const;
+        mutable std::vector<AuraTypeTotals> m_auraTypeTotals;
+        mutable uint32 m_auraTypeTotalsVersion;    // SpellMgr spell group data version m_auraTypeTotals was built with
         AuraList m_scAuras;                        // cast singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
+
+        // applied auras which can proc through ProcDamageAndSpellFor, kept in m_appliedAuras order
+        struct ProcAuraEntry
+        {
+            uint32 SpellId;
+            uint32 ProcFlags;
+            AuraApplication* AurApp;
+        };
+
+        void _AddProcAura(AuraApplication* aurApp);
+        void _RemoveProcAura(AuraApplication* aurApp);
+        void _RebuildProcAuras();
+        std::vector<ProcAuraEntry> m_procAuras;
+        uint32 m_procAurasFlags;                   // all ProcFlags of m_procAuras
+        uint32 m_procAurasVersion;                 // SpellMgr proc data version m_procAuras was built with
+        static ProcAuraStatistics _procAuraStatistics;
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
         uint32 m_interruptMask;
 
@@ -2325,6 +2382,8 @@ class Unit : public WorldObject
     private:
 
         uint32 m_state;                                     // Even derived shouldn't modify
+        mutable MapObjectHandle m_ownerHandle;              // last resolved owner and charmer, see GetOwner/GetCharmer
+        mutable MapObjectHandle m_charmerHandle;
         uint32 m_CombatTimer;
         TimeTrackerSmall m_movesplineTimer;
 
@@ -29,6 +29,7 @@
 #include "UnitAI.h"
 #include "GameObjectAI.h"
 #include "WorldStatePackets.h"
+#include <algorithm>
 
 bool GameEventMgr::CheckOneGameEvent(uint16 entry) const
 {
@@ -1167,6 +1168,28 @@ void GameEventMgr::UpdateEventNPCVendor(uint16 event_id, bool activate)
     }
 }
 
+static void SpawnEventCreature(ObjectGuid::LowType spawnId, Map* map)
+{
+    Creature* creature = new Creature();
+    //TC_LOG_DEBUG("misc", "Spawning creature %u", spawnId);
+    if (!creature->LoadCreatureFromDB(spawnId, map))
+        delete creature;
+}
+
+static void SpawnEventGameObject(ObjectGuid::LowType spawnId, Map* map)
+{
+    GameObject* pGameobject = new GameObject;
+    //TC_LOG_DEBUG("misc", "Spawning gameobject %u", spawnId);
+    /// @todo find out when it is add to map
+    if (!pGameobject->LoadGameObjectFromDB(spawnId, map, false))
+        delete pGameobject;
+    else
+    {
+        if (pGameobject->isSpawnedByDefault())
+            map->AddToMap(pGameobject);
+    }
+}
+
 void GameEventMgr::GameEventSpawn(int16 event_id)
 {
     int32 internal_event_id = mGameEvent.size() + event_id - 1;
@@ -1178,6 +1201,9 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         return;
     }
 
+    // with a time budget set loaded grids are filled by their maps over the next updates
+    bool staged = sWorld->getIntConfig(CONFIG_EVENT_STAGED_SPAWN_TIME) != 0;
+
     for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // Add to correct cell
@@ -1190,10 +1216,10 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
             // We use spawn coords to spawn
             if (!map->Instanceable() && map->IsGridLoaded(data->posX, data->posY))
             {
-                Creature* creature = new Creature();
-                //TC_LOG_DEBUG("misc", "Spawning creature %u", *itr);
-                if (!creature->LoadCreatureFromDB(*itr, map))
-                    delete creature;
+                if (staged)
+                    StageSpawn(event_id, data->mapid, *itr, true);
+                else
+                    SpawnEventCreature(*itr, map);
             }
         }
     }
@@ -1217,16 +1243,10 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
             // We use current coords to unspawn, not spawn coords since creature can have changed grid
             if (!map->Instanceable() && map->IsGridLoaded(data->posX, data->posY))
             {
-                GameObject* pGameobject = new GameObject;
-                //TC_LOG_DEBUG("misc", "Spawning gameobject %u", *itr);
-                /// @todo find out when it is add to map
-                if (!pGameobject->LoadGameObjectFromDB(*itr, map, false))
-                    delete pGameobject;
+                if (staged)
+                    StageSpawn(event_id, data->mapid, *itr, false);
                 else
-                {
-                    if (pGameobject->isSpawnedByDefault())
-                        map->AddToMap(pGameobject);
-                }
+                    SpawnEventGameObject(*itr, map);
             }
         }
     }
@@ -1242,10 +1262,99 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         sPoolMgr->SpawnPool(*itr);
 }
 
+void GameEventMgr::StageSpawn(int16 event_id, uint32 mapId, ObjectGuid::LowType spawnId, bool isCreature)
+{
+    GameEventStagedSpawn spawn;
+    spawn.EventId = event_id;
+    spawn.SpawnId = spawnId;
+    spawn.IsCreature = isCreature;
+
+    std::lock_guard<std::mutex> lock(_stagedSpawnsLock);
+    _stagedSpawns[mapId].push_back(spawn);
+    ++_stagedSpawnCount;
+}
+
+void GameEventMgr::CancelStagedSpawns(int16 event_id)
+{
+    if (!_stagedSpawnCount)
+        return;
+
+    std::lock_guard<std::mutex> lock(_stagedSpawnsLock);
+    for (auto itr = _stagedSpawns.begin(); itr != _stagedSpawns.end();)
+    {
+        GameEventStagedSpawnQueue& queue = itr->second;
+        std::size_t size = queue.size();
+        queue.erase(std::remove_if(queue.begin(), queue.end(), [event_id](GameEventStagedSpawn const& spawn) { return spawn.EventId == event_id; }), queue.end());
+        _stagedSpawnCount -= uint32(size - queue.size());
+
+        if (queue.empty())
+            itr = _stagedSpawns.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+void GameEventMgr::UpdateStagedSpawns(Map* map)
+{
+    if (!_stagedSpawnCount || map->Instanceable())
+        return;
+
+    uint32 budget = sWorld->getIntConfig(CONFIG_EVENT_STAGED_SPAWN_TIME);
+    uint32 startTime = getMSTime();
+    do
+    {
+        GameEventStagedSpawn spawn;
+        {
+            std::lock_guard<std::mutex> lock(_stagedSpawnsLock);
+            auto itr = _stagedSpawns.find(map->GetId());
+            if (itr == _stagedSpawns.end())
+                return;
+
+            spawn = itr->second.front();
+            itr->second.pop_front();
+            if (itr->second.empty())
+                _stagedSpawns.erase(itr);
+            --_stagedSpawnCount;
+        }
+
+        // the grid may have been unloaded, or loaded again together with this spawn, since the event started
+        if (spawn.IsCreature)
+        {
+            CreatureData const* data = sObjectMgr->GetCreatureData(spawn.SpawnId);
+            if (data && map->IsGridLoaded(data->posX, data->posY) && !map->GetCreatureBySpawnIdStore().count(spawn.SpawnId))
+                SpawnEventCreature(spawn.SpawnId, map);
+        }
+        else
+        {
+            GameObjectData const* data = sObjectMgr->GetGOData(spawn.SpawnId);
+            if (data && map->IsGridLoaded(data->posX, data->posY) && !map->GetGameObjectBySpawnIdStore().count(spawn.SpawnId))
+                SpawnEventGameObject(spawn.SpawnId, map);
+        }
+    } while (!budget || getMSTimeDiff(startTime, getMSTime()) < budget);
+}
+
+uint32 GameEventMgr::GetStagedSpawnCount(int16 event_id)
+{
+    if (!_stagedSpawnCount)
+        return 0;
+
+    uint32 count = 0;
+    std::lock_guard<std::mutex> lock(_stagedSpawnsLock);
+    for (auto const& queue : _stagedSpawns)
+        for (GameEventStagedSpawn const& spawn : queue.second)
+            if (spawn.EventId == event_id)
+                ++count;
+
+    return count;
+}
+
 void GameEventMgr::GameEventUnspawn(int16 event_id)
 {
     int32 internal_event_id = mGameEvent.size() + event_id - 1;
 
+    // objects not spawned yet must not appear after the event ended
+    CancelStagedSpawns(event_id);
+
     if (internal_event_id < 0 || internal_event_id >= int32(mGameEventCreatureGuids.size()))
     {
         TC_LOG_ERROR("gameevent", "GameEventMgr::GameEventUnspawn attempt access to out of range mGameEventCreatureGuids element %i (size: %zu)",
@@ -1512,7 +1621,7 @@ void GameEventMgr::UpdateWorldStates(uint16 event_id, bool Activate)
     }
 }
 
-GameEventMgr::GameEventMgr() : isSystemInit(false) { }
+GameEventMgr::GameEventMgr() : isSystemInit(false), _stagedSpawnCount(0) { }
 
 void GameEventMgr::HandleQuestComplete(uint32 quest_id)
 {
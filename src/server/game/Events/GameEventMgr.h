@@ -23,6 +23,9 @@
 #include "SharedDefines.h"
 #include "Define.h"
 #include "ObjectGuid.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
 
 #define max_ge_check_delay DAY  // 1 day in seconds
 
@@ -93,6 +96,15 @@ struct NPCVendorEntry
 class Player;
 class Creature;
 class Quest;
+class Map;
+
+/// Creature or gameobject of a game event left for its map to spawn, see Event.StagedSpawnTime
+struct GameEventStagedSpawn
+{
+    int16 EventId;
+    ObjectGuid::LowType SpawnId;
+    bool IsCreature;
+};
 
 class GameEventMgr
 {
@@ -127,6 +139,11 @@ class GameEventMgr
         uint64 GetNPCFlag(Creature* cr);
         uint32 GetNpcTextId(uint32 guid);
         uint16 GetEventIdForQuest(Quest const* quest) const;
+
+        /// Spawns game event objects staged for this map until the per update time budget is used, called from Map::Update
+        void UpdateStagedSpawns(Map* map);
+        /// Number of objects of event_id still waiting for their map to spawn them
+        uint32 GetStagedSpawnCount(int16 event_id);
     private:
         void SendWorldStateUpdate(Player* player, uint16 event_id);
         void AddActiveEvent(uint16 event_id) { m_ActiveEvents.insert(event_id); }
@@ -136,6 +153,8 @@ class GameEventMgr
         void GameEventSpawn(int16 event_id);
         void GameEventUnspawn(int16 event_id);
         void ChangeEquipOrModel(int16 event_id, bool activate);
+        void StageSpawn(int16 event_id, uint32 mapId, ObjectGuid::LowType spawnId, bool isCreature);
+        void CancelStagedSpawns(int16 event_id);
         void UpdateEventQuests(uint16 event_id, bool activate);
         void UpdateWorldStates(uint16 event_id, bool Activate);
         void UpdateEventNPCFlags(uint16 event_id);
@@ -180,6 +199,11 @@ class GameEventMgr
         ActiveEvents m_ActiveEvents;
         std::unordered_map<uint32, uint16> _questToEventLinks;
         bool isSystemInit;
+
+        typedef std::deque<GameEventStagedSpawn> GameEventStagedSpawnQueue;
+        std::mutex _stagedSpawnsLock;
+        std::unordered_map<uint32 /*mapId*/, GameEventStagedSpawnQueue> _stagedSpawns;
+        std::atomic<uint32> _stagedSpawnCount;              // lets map updates skip the lock when nothing is staged
     public:
         GameEventGuidMap  mGameEventCreatureGuids;
         GameEventGuidMap  mGameEventGameobjectGuids;
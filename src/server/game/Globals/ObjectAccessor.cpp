@@ -142,6 +142,17 @@ Unit* ObjectAccessor::GetUnit(WorldObject const& u, ObjectGuid const& guid)
     return GetCreature(u, guid);
 }
 
+Unit* ObjectAccessor::GetUnit(WorldObject const& u, ObjectGuid const& guid, MapObjectHandle& handle)
+{
+    if (WorldObject* object = u.GetMap()->GetObjectByHandle(handle))
+        if (object->GetGUID() == guid)
+            return object->ToUnit();
+
+    Unit* unit = GetUnit(u, guid);
+    handle = unit ? unit->GetMapHandle() : MapObjectHandle();
+    return unit;
+}
+
 Creature* ObjectAccessor::GetCreature(WorldObject const& u, ObjectGuid const& guid)
 {
     return u.GetMap()->GetCreature(guid);
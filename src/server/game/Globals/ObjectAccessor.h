@@ -38,6 +38,7 @@ class DynamicObject;
 class WorldObject;
 class Vehicle;
 class Map;
+struct MapObjectHandle;
 class WorldRunnable;
 class Transport;
 
@@ -111,6 +112,8 @@ class ObjectAccessor
         static DynamicObject* GetDynamicObject(WorldObject const& u, ObjectGuid const& guid);
         static AreaTrigger* GetAreaTrigger(WorldObject const& u, ObjectGuid const& guid);
         static Unit* GetUnit(WorldObject const&, ObjectGuid const& guid);
+        // resolves through handle while it still refers to guid, otherwise looks guid up and refreshes handle
+        static Unit* GetUnit(WorldObject const&, ObjectGuid const& guid, MapObjectHandle& handle);
         static Creature* GetCreature(WorldObject const& u, ObjectGuid const& guid);
         static Pet* GetPet(WorldObject const&, ObjectGuid const& guid);
         static Player* GetPlayer(Map const*, ObjectGuid const& guid);
@@ -2233,9 +2233,10 @@ bool ObjectMgr::GetPlayerNameByGUID(ObjectGuid const& guid, std::string& name)
         return true;
     }
 
-    if (CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(guid))
+    CharacterInfo characterInfo;
+    if (sWorld->GetCharacterInfo(guid, characterInfo))
     {
-        name = characterInfo->Name;
+        name = characterInfo.Name;
         return true;
     }
 
@@ -2251,10 +2252,11 @@ bool ObjectMgr::GetPlayerNameAndClassByGUID(ObjectGuid const& guid, std::string&
         return true;
     }
 
-    if (CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(guid))
+    CharacterInfo characterInfo;
+    if (sWorld->GetCharacterInfo(guid, characterInfo))
     {
-        name = characterInfo->Name;
-        _class = characterInfo->Class;
+        name = characterInfo.Name;
+        _class = characterInfo.Class;
         return true;
     }
 
@@ -2266,8 +2268,9 @@ uint32 ObjectMgr::GetPlayerTeamByGUID(ObjectGuid const& guid)
     if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
         return player->GetTeam();
 
-    if (CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(guid))
-        return Player::TeamForRace(characterInfo->Race);
+    CharacterInfo characterInfo;
+    if (sWorld->GetCharacterInfo(guid, characterInfo))
+        return Player::TeamForRace(characterInfo.Race);
 
     return 0;
 }
@@ -17,6 +17,7 @@
  */
 
 #include "AccountMgr.h"
+#include "AchievementPackets.h"
 #include "CalendarMgr.h"
 #include "Chat.h"
 #include "Config.h"
@@ -29,6 +30,7 @@
 #include "Log.h"
 #include "ScriptMgr.h"
 #include "SocialMgr.h"
+#include "WhoListStorage.h"
 #include "Opcodes.h"
 #include "ChatPackets.h"
 
@@ -1034,7 +1036,9 @@ Guild::Guild():
     m_eventLog(NULL),
     m_newsLog(NULL),
     m_achievementMgr(this),
-    _level(1)
+    _level(1),
+    _rosterChanged(true),
+    _rosterBuildTime(0)
 {
     memset(&m_bankEventLog, 0, (GUILD_BANK_MAX_TABS + 1) * sizeof(LogHolder*));
 }
@@ -1209,7 +1213,8 @@ void Guild::UpdateMemberData(Player* player, uint8 dataid, uint32 value)
                 TC_LOG_ERROR("guild", "Guild::UpdateMemberData: Called with incorrect DATAID %u (value %u)", dataid, value);
                 return;
         }
-        //HandleRoster();
+
+        _InvalidateRoster();
     }
 }
 
@@ -1220,6 +1225,8 @@ void Guild::OnPlayerStatusChange(Player* player, uint32 flag, bool state)
         if (state)
             member->AddFlag(flag);
         else member->RemFlag(flag);
+
+        _InvalidateRoster();
     }
 }
 
@@ -1234,6 +1241,8 @@ bool Guild::SetName(std::string const& name)
     stmt->setUInt64(1, GetId());
     CharacterDatabase.Execute(stmt);
 
+    sWhoListStorage->UpdateGuildName(GetId(), m_name);
+
     /* TODO 6.x update me
     ObjectGuid guid = GetGUID();
     WorldPacket data(SMSG_GUILD_NAME_CHANGED, 24 + 8 + 1);
@@ -1263,6 +1272,17 @@ bool Guild::SetName(std::string const& name)
 
 void Guild::HandleRoster(WorldSession* session)
 {
+    std::lock_guard<std::mutex> lock(_rosterLock);
+
+    // offline members show time since logout, refresh that once in a while even if nothing changed
+    time_t now = ::time(NULL);
+    if (!_rosterChanged.exchange(false) && now < _rosterBuildTime + MINUTE)
+    {
+        TC_LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [%s] (cached)", session->GetPlayerInfo().c_str());
+        session->SendPacket(&_rosterPacket);
+        return;
+    }
+
     WorldPackets::Guild::GuildRoster roster;
 
     roster.NumAccounts = int32(m_accountsNumber);
@@ -1282,7 +1302,7 @@ void Guild::HandleRoster(WorldSession* session)
         memberData.AreaID = int32(member->GetZoneId());
         memberData.PersonalAchievementPoints = int32(member->GetAchievementPoints());
         memberData.GuildReputation = int32(member->GetTotalReputation());
-        memberData.LastSave = float(member->IsOnline() ? 0.0f : float(::time(NULL) - member->GetLogoutTime()) / DAY);
+        memberData.LastSave = float(member->IsOnline() ? 0.0f : float(now - member->GetLogoutTime()) / DAY);
 
         //GuildRosterProfessionData
 
@@ -1305,8 +1325,12 @@ void Guild::HandleRoster(WorldSession* session)
     roster.WelcomeText = m_motd;
     roster.InfoText = m_info;
 
+    roster.Write();
+    _rosterPacket = roster.Move();
+    _rosterBuildTime = now;
+
     TC_LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [%s]", session->GetPlayerInfo().c_str());
-    session->SendPacket(roster.Write());
+    session->SendPacket(&_rosterPacket);
 }
 
 void Guild::SendQueryResponse(WorldSession* session)
@@ -1409,6 +1433,7 @@ void Guild::HandleSetMOTD(WorldSession* session, std::string const& motd)
     else
     {
         m_motd = motd;
+        _InvalidateRoster();
 
         sScriptMgr->OnGuildMOTDChanged(this, motd);
 
@@ -1430,6 +1455,7 @@ void Guild::HandleSetInfo(WorldSession* session, std::string const& info)
     if (_HasRankRight(session->GetPlayer(), GR_RIGHT_MODIFY_GUILD_INFO))
     {
         m_info = info;
+        _InvalidateRoster();
 
         sScriptMgr->OnGuildInfoChanged(this, info);
 
@@ -1474,6 +1500,7 @@ void Guild::HandleSetNewGuildMaster(WorldSession* session, std::string const& na
         {
             _SetLeaderGUID(newGuildMaster);
             oldGuildMaster->ChangeRank(GR_INITIATE);
+            _InvalidateRoster();
 
             SendEventNewLeader(newGuildMaster, oldGuildMaster);
         }
@@ -1511,6 +1538,7 @@ void Guild::HandleSetMemberNote(WorldSession* session, std::string const& note,
         else
             member->SetOfficerNote(note);
 
+        _InvalidateRoster();
         HandleRoster(session); // FIXME - We should send SMSG_GUILD_MEMBER_UPDATE_NOTE
 
         WorldPackets::Guild::GuildMemberUpdateNote updateNote;
@@ -1785,6 +1813,7 @@ void Guild::HandleUpdateMemberRank(WorldSession* session, ObjectGuid guid, bool
 
         uint32 newRankId = member->GetRankId() + (demote ? 1 : -1);
         member->ChangeRank(newRankId);
+        _InvalidateRoster();
         _LogEvent(demote ? GUILD_EVENT_LOG_DEMOTE_PLAYER : GUILD_EVENT_LOG_PROMOTE_PLAYER, player->GetGUID().GetCounter(), member->GetGUID().GetCounter(), newRankId);
         //_BroadcastEvent(demote ? GE_DEMOTION : GE_PROMOTION, ObjectGuid::Empty, player->GetName().c_str(), name.c_str(), _GetRankName(newRankId).c_str());
     }
@@ -1942,6 +1971,8 @@ void Guild::HandleMemberLogout(WorldSession* session)
         member->SetStats(player);
         member->UpdateLogoutTime();
         member->ResetFlags();
+        _RemoveOnlineMember(member);
+        _InvalidateRoster();
     }
 
     SendEventPresenceChanged(session, false, true);
@@ -2159,6 +2190,8 @@ void Guild::SendLoginInfo(WorldSession* session)
 
     member->SetStats(player);
     member->AddFlag(GUILDMEMBER_STATUS_ONLINE);
+    _AddOnlineMember(member);
+    _InvalidateRoster();
 }
 
 void Guild::SendEventBankMoneyChanged()
@@ -2502,19 +2535,47 @@ void Guild::BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const
 
 void Guild::BroadcastPacket(WorldPacket const* packet) const
 {
-    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (Player* player = itr->second->FindPlayer())
+    for (Member const* member : _onlineMembers)
+        if (Player* player = member->FindPlayer())
             player->GetSession()->SendPacket(packet);
 }
 
 void Guild::BroadcastPacketIfTrackingAchievement(WorldPacket const* packet, uint32 criteriaId) const
 {
-    for (Members::const_iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
-        if (itr->second->IsTrackingCriteriaId(criteriaId))
-            if (Player* player = itr->second->FindPlayer())
+    for (Member const* member : _onlineMembers)
+        if (member->IsTrackingCriteriaId(criteriaId))
+            if (Player* player = member->FindPlayer())
                 player->GetSession()->SendPacket(packet);
 }
 
+void Guild::BroadcastCriteriaProgress(std::vector<WorldPackets::Achievement::GuildCriteriaProgress> const& progress) const
+{
+    WorldPackets::Achievement::GuildCriteriaUpdate guildCriteriaUpdate;
+    if (progress.size() == 1)
+    {
+        guildCriteriaUpdate.Progress = progress;
+        BroadcastPacketIfTrackingAchievement(guildCriteriaUpdate.Write(), progress.front().CriteriaID);
+        return;
+    }
+
+    for (Member const* member : _onlineMembers)
+    {
+        guildCriteriaUpdate.Progress.clear();
+        for (WorldPackets::Achievement::GuildCriteriaProgress const& criteriaProgress : progress)
+            if (member->IsTrackingCriteriaId(criteriaProgress.CriteriaID))
+                guildCriteriaUpdate.Progress.push_back(criteriaProgress);
+
+        if (guildCriteriaUpdate.Progress.empty())
+            continue;
+
+        if (Player* player = member->FindPlayer())
+        {
+            guildCriteriaUpdate.Clear();
+            player->GetSession()->SendPacket(guildCriteriaUpdate.Write());
+        }
+    }
+}
+
 void Guild::MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 maxLevel, uint32 minRank)
 {
     uint32 count = 0;
@@ -2676,8 +2737,12 @@ void Guild::DeleteMember(ObjectGuid guid, bool isDisbanding, bool isKicked, bool
     sScriptMgr->OnGuildRemoveMember(this, guid, isDisbanding, isKicked);
 
     if (Member* member = GetMember(guid))
+    {
+        _RemoveOnlineMember(member);
         delete member;
+    }
     m_members.erase(guid);
+    _InvalidateRoster();
 
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
     Player* player = ObjectAccessor::FindConnectedPlayer(guid);
@@ -2704,6 +2769,7 @@ bool Guild::ChangeMemberRank(ObjectGuid guid, uint8 newRank)
         if (Member* member = GetMember(guid))
         {
             member->ChangeRank(newRank);
+            _InvalidateRoster();
             return true;
         }
     return false;
@@ -2827,6 +2893,22 @@ bool Guild::_CreateRank(std::string const& name, uint32 rights)
 
 // Updates the number of accounts that are in the guild
 // Player may have many characters in the guild, but with the same account
+void Guild::_AddOnlineMember(Member* member)
+{
+    if (std::find(_onlineMembers.begin(), _onlineMembers.end(), member) == _onlineMembers.end())
+        _onlineMembers.push_back(member);
+}
+
+void Guild::_RemoveOnlineMember(Member* member)
+{
+    auto itr = std::find(_onlineMembers.begin(), _onlineMembers.end(), member);
+    if (itr == _onlineMembers.end())
+        return;
+
+    *itr = _onlineMembers.back();
+    _onlineMembers.pop_back();
+}
+
 void Guild::_UpdateAccountsNumber()
 {
     // We use a set to be sure each element will be unique
@@ -2835,6 +2917,7 @@ void Guild::_UpdateAccountsNumber()
         accountsIdSet.insert(itr->second->GetAccountId());
 
     m_accountsNumber = accountsIdSet.size();
+    _InvalidateRoster();
 }
 
 // Detects if player is the guild master.
@@ -2886,6 +2969,7 @@ void Guild::_SetLeaderGUID(Member* pLeader)
 
     m_leaderGuid = pLeader->GetGUID();
     pLeader->ChangeRank(GR_GUILDMASTER);
+    _InvalidateRoster();
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_LEADER);
     stmt->setUInt64(0, m_leaderGuid.GetCounter());
@@ -3340,6 +3424,7 @@ void Guild::SendGuildRanksUpdate(ObjectGuid setterGuid, ObjectGuid targetGuid, u
     BroadcastPacket(rankChange.Write());
 
     member->ChangeRank(rank);
+    _InvalidateRoster();
 
     TC_LOG_DEBUG("network", "SMSG_GUILD_RANKS_UPDATE [Broadcast] Target: %s, Issuer: %s, RankId: %u",
         targetGuid.ToString().c_str(), setterGuid.ToString().c_str(), rank);
@@ -3356,6 +3441,8 @@ void Guild::ResetTimes(bool weekly)
             player->GetSession()->SendPacket(packet.Write());
         }
     }
+
+    _InvalidateRoster();
 }
 
 void Guild::AddGuildNews(uint8 type, ObjectGuid guid, uint32 flags, uint32 value)
@@ -26,11 +26,18 @@
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "DBCStore.h"
+#include <atomic>
+#include <mutex>
 
 class Item;
 
 namespace WorldPackets
 {
+    namespace Achievement
+    {
+        struct GuildCriteriaProgress;
+    }
+
     namespace Guild
     {
         class GuildBankLogQueryResults;
@@ -838,6 +845,8 @@ public:
     void BroadcastPacketToRank(WorldPacket* packet, uint8 rankId) const;
     void BroadcastPacket(WorldPacket const* packet) const;
     void BroadcastPacketIfTrackingAchievement(WorldPacket const* packet, uint32 criteriaId) const;
+    // Sends every online member one packet with the progress of the criteria it tracks
+    void BroadcastCriteriaProgress(std::vector<WorldPackets::Achievement::GuildCriteriaProgress> const& progress) const;
 
     void MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 maxLevel, uint32 minRank);
 
@@ -903,6 +912,15 @@ protected:
 
     uint8 _level;
 
+    // Members with a player in world, kept in sync at login/logout so broadcasts do not walk the whole roster
+    std::vector<Member*> _onlineMembers;
+
+    // SMSG_GUILD_ROSTER is rebuilt only after roster data changed, roster requests may come from several map threads
+    std::mutex _rosterLock;
+    std::atomic<bool> _rosterChanged;
+    time_t _rosterBuildTime;
+    WorldPacket _rosterPacket;
+
 private:
     inline uint8 _GetRanksSize() const { return uint8(m_ranks.size()); }
     inline const RankInfo* GetRankInfo(uint8 rankId) const { return rankId < _GetRanksSize() ? &m_ranks[rankId] : NULL; }
@@ -942,6 +960,10 @@ private:
         return NULL;
     }
 
+    void _AddOnlineMember(Member* member);
+    void _RemoveOnlineMember(Member* member);
+    inline void _InvalidateRoster() { _rosterChanged = true; }
+
     inline void _DeleteMemberFromDB(ObjectGuid::LowType lowguid) const
     {
         PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_MEMBER);
@@ -81,12 +81,12 @@ struct MembershipRequest
         uint8 GetAvailability() const  { return _availability; }
         uint8 GetClassRoles() const    { return _classRoles; }
         uint8 GetInterests() const     { return _interests; }
-        uint8 GetClass() const         { return sWorld->GetCharacterInfo(GetPlayerGUID())->Class; }
-        uint8 GetLevel() const         { return sWorld->GetCharacterInfo(GetPlayerGUID())->Level; }
+        uint8 GetClass() const         { CharacterInfo info; return sWorld->GetCharacterInfo(GetPlayerGUID(), info) ? info.Class : 0; }
+        uint8 GetLevel() const         { CharacterInfo info; return sWorld->GetCharacterInfo(GetPlayerGUID(), info) ? info.Level : 0; }
         time_t GetSubmitTime() const   { return _time; }
         time_t GetExpiryTime() const   { return time_t(_time + 30 * 24 * 3600); } // Adding 30 days
         std::string const& GetComment() const { return _comment; }
-        std::string const& GetName() const    { return sWorld->GetCharacterInfo(GetPlayerGUID())->Name; }
+        std::string GetName() const           { CharacterInfo info; return sWorld->GetCharacterInfo(GetPlayerGUID(), info) ? info.Name : std::string(); }
 
     private:
         std::string _comment;
@@ -17,6 +17,7 @@
 
 #include "Common.h"
 #include "GuildMgr.h"
+#include "WhoListStorage.h"
 
 GuildMgr::GuildMgr() : NextGuildId(UI64LIT(1))
 { }
@@ -30,6 +31,9 @@ GuildMgr::~GuildMgr()
 void GuildMgr::AddGuild(Guild* guild)
 {
     GuildStore[guild->GetId()] = guild;
+
+    // members added while the guild was being created did not find its name yet
+    sWhoListStorage->UpdateGuildName(guild->GetId(), guild->GetName());
 }
 
 void GuildMgr::RemoveGuild(ObjectGuid::LowType guildId)
@@ -522,6 +526,26 @@ void GuildMgr::LoadGuildRewards()
     TC_LOG_INFO("server.loading", ">> Loaded %u guild reward definitions in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
+void GuildMgr::ScheduleCriteriaUpdates(ObjectGuid::LowType guildId)
+{
+    std::lock_guard<std::mutex> lock(_pendingCriteriaUpdatesLock);
+    _pendingCriteriaUpdates.push_back(guildId);
+}
+
+void GuildMgr::SendPendingCriteriaUpdates()
+{
+    std::vector<ObjectGuid::LowType> guildIds;
+    {
+        std::lock_guard<std::mutex> lock(_pendingCriteriaUpdatesLock);
+        guildIds.swap(_pendingCriteriaUpdates);
+    }
+
+    // guilds disbanded since scheduling are simply not found
+    for (ObjectGuid::LowType guildId : guildIds)
+        if (Guild* guild = GetGuildById(guildId))
+            guild->GetAchievementMgr().SendPendingCriteriaUpdates();
+}
+
 void GuildMgr::ResetTimes(bool week)
 {
     CharacterDatabase.Execute(CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_MEMBER_WITHDRAW));
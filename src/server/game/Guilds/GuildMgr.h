@@ -55,11 +55,18 @@ public:
     std::vector<GuildReward> const& GetGuildRewards() const { return GuildRewards; }
 
     void ResetTimes(bool week);
+
+    // Guild criteria progress is broadcast once per world update, see AchievementMgr<Guild>::SendCriteriaUpdate
+    void ScheduleCriteriaUpdates(ObjectGuid::LowType guildId);
+    void SendPendingCriteriaUpdates();
 protected:
     typedef std::unordered_map<ObjectGuid::LowType, Guild*> GuildContainer;
     ObjectGuid::LowType NextGuildId;
     GuildContainer GuildStore;
     std::vector<GuildReward> GuildRewards;
+
+    std::mutex _pendingCriteriaUpdatesLock;
+    std::vector<ObjectGuid::LowType> _pendingCriteriaUpdates;
 };
 
 #define sGuildMgr GuildMgr::instance()
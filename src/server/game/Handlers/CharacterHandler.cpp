@@ -1744,16 +1744,16 @@ void WorldSession::HandleCharRaceOrFactionChangeCallback(PreparedQueryResult res
     }
 
     // get the players old (at this moment current) race
-    CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(factionChangeInfo->Guid);
-    if (!characterInfo)
+    CharacterInfo characterInfo;
+    if (!sWorld->GetCharacterInfo(factionChangeInfo->Guid, characterInfo))
     {
         SendCharFactionChange(CHAR_CREATE_ERROR, factionChangeInfo);
         return;
     }
 
-    uint8 oldRace     = characterInfo->Race;
-    uint8 playerClass = characterInfo->Class;
-    uint8 level       = characterInfo->Level;
+    uint8 oldRace     = characterInfo.Race;
+    uint8 playerClass = characterInfo.Class;
+    uint8 level       = characterInfo.Level;
 
     if (!sObjectMgr->GetPlayerInfo(factionChangeInfo->RaceID, playerClass))
     {
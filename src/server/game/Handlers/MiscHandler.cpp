@@ -58,6 +58,7 @@
 #include "MiscPackets.h"
 #include "AchievementPackets.h"
 #include "WhoPackets.h"
+#include "WhoListStorage.h"
 
 void WorldSession::HandleRepopRequest(WorldPackets::Misc::RepopRequest& /*packet*/)
 {
@@ -143,72 +144,36 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
 
     WorldPackets::Who::WhoResponsePkt response;
 
-    boost::shared_lock<boost::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+    bool twoSideWhoList = HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST);
+    bool seeAllSecLevels = HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS);
+    uint32 maxWho = sWorld->getIntConfig(CONFIG_MAX_WHO);
 
-    HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    // level, race, class and zone filters are answered by the who list index
+    sWhoListStorage->Visit(uint32(std::max(request.MinLevel, 0)), uint32(std::max(request.MaxLevel, 0)), request.RaceFilter, request.ClassFilter, whoRequest.Areas, [&](WhoListPlayerInfo const& info)
     {
-        Player* target = itr->second;
+        Player* target = info.Target;
         // player can see member of other team only if has RBAC_PERM_TWO_SIDE_WHO_LIST
-        if (target->GetTeam() != team && !HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
-            continue;
+        if (info.Team != team && !twoSideWhoList)
+            return true;
 
         // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if has RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS
-        if (target->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList) && !HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS))
-            continue;
-
-        // do not process players which are not in world
-        if (!target->IsInWorld())
-            continue;
+        if (target->GetSession()->GetSecurity() > AccountTypes(gmLevelInWhoList) && !seeAllSecLevels)
+            return true;
 
         // check if target is globally visible for player
         if (!target->IsVisibleGloballyFor(_player))
-            continue;
-
-        // check if target's level is in level range
-        uint8 lvl = target->getLevel();
-        if (lvl < request.MinLevel || lvl > request.MaxLevel)
-            continue;
+            return true;
 
-        // check if class matches classmask
-        if (request.ClassFilter >= 0 && !(request.ClassFilter & (1 << target->getClass())))
-            continue;
+        if (!wPlayerName.empty() && info.Name.find(wPlayerName) == std::wstring::npos)
+            return true;
 
-        // check if race matches racemask
-        if (request.RaceFilter >= 0 && !(request.RaceFilter & (1 << target->getRace())))
-            continue;
-
-        if (!whoRequest.Areas.empty())
-        {
-            if (std::find(whoRequest.Areas.begin(), whoRequest.Areas.end(), target->GetZoneId()) == whoRequest.Areas.end())
-                continue;
-        }
-
-        std::wstring wTargetName;
-
-        if (!Utf8toWStr(target->GetName(), wTargetName))
-            continue;
-
-        wstrToLower(wTargetName);
-
-        if (!wPlayerName.empty() && wTargetName.find(wPlayerName) == std::wstring::npos)
-            continue;
-
-        Guild* targetGuild = target->GetGuild();
-        std::wstring wTargetGuildName;
-
-        if (!Utf8toWStr(targetGuild ? targetGuild->GetName() : "", wTargetGuildName))
-            continue;
-
-        wstrToLower(wTargetGuildName);
-
-        if (!wGuildName.empty() && wTargetGuildName.find(wGuildName) == std::wstring::npos)
-            continue;
+        if (!wGuildName.empty() && info.GuildName.find(wGuildName) == std::wstring::npos)
+            return true;
 
         if (!wWords.empty())
         {
             std::string aName;
-            if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(target->GetZoneId()))
+            if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(info.ZoneId))
                 aName = areaEntry->AreaName_lang;
 
             bool show = false;
@@ -216,8 +181,8 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
             {
                 if (!wWords[i].empty())
                 {
-                    if (wTargetName.find(wWords[i]) != std::wstring::npos ||
-                        wTargetGuildName.find(wWords[i]) != std::wstring::npos ||
+                    if (info.Name.find(wWords[i]) != std::wstring::npos ||
+                        info.GuildName.find(wWords[i]) != std::wstring::npos ||
                         Utf8FitTo(aName, wWords[i]))
                     {
                         show = true;
@@ -227,30 +192,29 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
             }
 
             if (!show)
-                continue;
+                return true;
         }
 
         WorldPackets::Who::WhoEntry whoEntry;
-        if (!whoEntry.PlayerData.Initialize(target->GetGUID(), target))
-            continue;
+        if (!whoEntry.PlayerData.Initialize(info.Guid, target))
+            return true;
 
-        if (targetGuild)
+        if (Guild* targetGuild = target->GetGuild())
         {
             whoEntry.GuildGUID = targetGuild->GetGUID();
             whoEntry.GuildVirtualRealmAddress = GetVirtualRealmAddress();
             whoEntry.GuildName = targetGuild->GetName();
         }
 
-        whoEntry.AreaID = target->GetZoneId();
+        whoEntry.AreaID = info.ZoneId;
         whoEntry.IsGM = target->IsGameMaster();
 
         response.Response.Entries.push_back(whoEntry);
 
         // 50 is maximum player count sent to client - can be overridden
         // through config, but is unstable
-        if (response.Response.Entries.size() >= sWorld->getIntConfig(CONFIG_MAX_WHO))
-            break;
-    }
+        return response.Response.Entries.size() < maxWho;
+    });
 
     SendPacket(response.Write());
 }
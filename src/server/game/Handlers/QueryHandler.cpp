@@ -37,6 +37,10 @@ void WorldSession::SendNameQueryOpcode(ObjectGuid guid)
 {
     Player* player = ObjectAccessor::FindConnectedPlayer(guid);
 
+    // characters that are not cached are loaded without blocking, World sends the response once they are
+    if (!player && !sWorld->GetCharacterInfoAsync(guid, GetAccountId()))
+        return;
+
     WorldPackets::Query::QueryPlayerNameResponse response;
     response.Player = guid;
 
@@ -22,6 +22,7 @@
 #include "CellImpl.h"
 #include "DisableMgr.h"
 #include "DynamicTree.h"
+#include "GameEventMgr.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
 #include "GridStates.h"
@@ -708,6 +709,9 @@ void Map::Update(const uint32 t_diff)
         i_scriptLock = false;
     }
 
+    // game event spawns left to this map when events are activated in stages
+    sGameEventMgr->UpdateStagedSpawns(this);
+
     MoveAllCreaturesInMoveList();
     MoveAllGameObjectsInMoveList();
 
@@ -30,6 +30,7 @@
 #include "MapRefManager.h"
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
+#include "MapObjectSlotTable.h"
 #include "ObjectGuid.h"
 
 #include <bitset>
@@ -458,6 +459,11 @@ class Map : public GridRefManager<NGridType>
 
         MapStoredObjectTypesContainer& GetObjectsStore() { return _objectsStore; }
 
+        MapObjectHandle AddToObjectSlots(WorldObject* object) { return _objectSlots.Insert(object); }
+        void RemoveFromObjectSlots(MapObjectHandle const& handle) { _objectSlots.Remove(handle); }
+        /// Object the handle was issued for if it is still in world on this map
+        WorldObject* GetObjectByHandle(MapObjectHandle const& handle) const { return _objectSlots.Find(handle); }
+
         typedef std::unordered_multimap<ObjectGuid::LowType, Creature*> CreatureBySpawnIdContainer;
         CreatureBySpawnIdContainer& GetCreatureBySpawnIdStore() { return _creatureBySpawnIdStore; }
 
@@ -706,6 +712,7 @@ class Map : public GridRefManager<NGridType>
 
         std::map<HighGuid, std::unique_ptr<ObjectGuidGeneratorBase>> _guidGenerators;
         MapStoredObjectTypesContainer _objectsStore;
+        MapObjectSlotTable _objectSlots;
         CreatureBySpawnIdContainer _creatureBySpawnIdStore;
         GameObjectBySpawnIdContainer _gameobjectBySpawnIdStore;
 
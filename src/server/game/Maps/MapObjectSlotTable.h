@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAP_OBJECT_SLOT_TABLE_H
+#define MAP_OBJECT_SLOT_TABLE_H
+
+#include "Define.h"
+#include "Errors.h"
+#include <vector>
+
+class WorldObject;
+
+/// Reference to an object in the slot table of the map it is in world on.
+/// The generation changes whenever the slot is freed, so a stale handle resolves to nothing.
+struct MapObjectHandle
+{
+    MapObjectHandle() : Index(0), Generation(0) { }
+
+    uint32 Index;                                           // 0 - no object, slot 0 of the table is never used
+    uint32 Generation;
+
+    bool IsEmpty() const { return !Index; }
+};
+
+/// Objects in world on a map, addressed by MapObjectHandle.
+/// Resolving a handle is an array access and a generation compare, no hashing.
+class MapObjectSlotTable
+{
+    public:
+        MapObjectSlotTable() : _slots(1, Slot()) { }
+
+        MapObjectHandle Insert(WorldObject* object)
+        {
+            MapObjectHandle handle;
+            if (!_freeSlots.empty())
+            {
+                handle.Index = _freeSlots.back();
+                _freeSlots.pop_back();
+            }
+            else
+            {
+                handle.Index = uint32(_slots.size());
+                _slots.push_back(Slot());
+            }
+
+            Slot& slot = _slots[handle.Index];
+            slot.Object = object;
+            handle.Generation = slot.Generation;
+            return handle;
+        }
+
+        void Remove(MapObjectHandle const& handle)
+        {
+            ASSERT(handle.Index && handle.Index < _slots.size() && _slots[handle.Index].Generation == handle.Generation);
+            Slot& slot = _slots[handle.Index];
+            slot.Object = nullptr;
+            ++slot.Generation;
+            _freeSlots.push_back(handle.Index);
+        }
+
+        WorldObject* Find(MapObjectHandle const& handle) const
+        {
+            if (handle.Index >= _slots.size())
+                return nullptr;
+
+            Slot const& slot = _slots[handle.Index];
+            return slot.Generation == handle.Generation ? slot.Object : nullptr;
+        }
+
+    private:
+        struct Slot
+        {
+            Slot() : Object(nullptr), Generation(0) { }
+
+            WorldObject* Object;
+            uint32 Generation;
+        };
+
+        std::vector<Slot> _slots;
+        std::vector<uint32> _freeSlots;
+};
+
+#endif
@@ -93,7 +93,15 @@ void TargetedMovementGeneratorMedium<T, D>::_setTargetLocation(T* owner, bool up
     bool forceDest = (owner->GetTypeId() == TYPEID_UNIT && owner->ToCreature()->IsPet()
         && owner->HasUnitState(UNIT_STATE_FOLLOW));
 
+    // pursuers of the same target mostly end up in the same corridor, let the path generator reuse theirs
+    i_path->ClearSharedPaths();
+    for (Reference<Unit, TargetedMovementGeneratorBase>* ref = i_target->GetFollowingRefManager().getFirst(); ref; ref = ref->next())
+        if (ref->GetSource() != this)
+            if (PathGenerator const* path = ref->GetSource()->GetPath())
+                i_path->AddSharedPath(path);
+
     bool result = i_path->CalculatePath(x, y, z, forceDest);
+    i_path->ClearSharedPaths();
     if (!result || (i_path->GetPathType() & PATHFIND_NOPATH))
     {
         // Cant reach target
@@ -28,10 +28,13 @@
 class TargetedMovementGeneratorBase
 {
     public:
-        TargetedMovementGeneratorBase(Unit* target) { i_target.link(target, this); }
+        TargetedMovementGeneratorBase(Unit* target) : i_path(NULL) { i_target.link(target, this); }
+        ~TargetedMovementGeneratorBase() { delete i_path; }
         void stopFollowing() { }
+        PathGenerator const* GetPath() const { return i_path; }
     protected:
         FollowerReference i_target;
+        PathGenerator* i_path;
 };
 
 template<class T, typename D>
@@ -39,12 +42,12 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
 {
     protected:
         TargetedMovementGeneratorMedium(Unit* target, float offset, float angle) :
-            TargetedMovementGeneratorBase(target), i_path(NULL),
+            TargetedMovementGeneratorBase(target),
             i_recheckDistance(0), i_offset(offset), i_angle(angle),
             i_recalculateTravel(false), i_targetReached(false)
         {
         }
-        ~TargetedMovementGeneratorMedium() { delete i_path; }
+        ~TargetedMovementGeneratorMedium() { }
 
     public:
         bool DoUpdate(T*, uint32);
@@ -55,7 +58,6 @@ class TargetedMovementGeneratorMedium : public MovementGeneratorMedium< T, D >,
     protected:
         void _setTargetLocation(T* owner, bool updateDestination);
 
-        PathGenerator* i_path;
         TimeTrackerSmall i_recheckDistance;
         float i_offset;
         float i_angle;
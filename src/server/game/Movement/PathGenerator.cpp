@@ -26,15 +26,83 @@
 #include "DisableMgr.h"
 #include "DetourCommon.h"
 #include "DetourNavMeshQuery.h"
+#include <mutex>
+
+////////////////// PathBufferPool //////////////////
+namespace
+{
+    // 256 bytes up to 64KB, enough for MAX_PATH_LENGTH_LIMIT polys (with scratch) and MAX_POINT_PATH_LENGTH_LIMIT points
+    uint32 const PATH_BUFFER_MIN_SIZE_SHIFT = 8;
+    uint32 const PATH_BUFFER_SIZE_CLASSES = 9;
+    // buffers kept per size class, anything above is returned to the heap
+    size_t const PATH_BUFFER_MAX_FREE = 256;
+
+    std::mutex PathBufferLock;
+    std::vector<void*> PathBufferFreeList[PATH_BUFFER_SIZE_CLASSES];
+}
+
+uint32 PathBufferPool::GetSizeClass(size_t size)
+{
+    uint32 sizeClass = 0;
+    while ((size_t(1) << (sizeClass + PATH_BUFFER_MIN_SIZE_SHIFT)) < size)
+        ++sizeClass;
+
+    return sizeClass;
+}
+
+void* PathBufferPool::Acquire(size_t size)
+{
+    uint32 sizeClass = GetSizeClass(size);
+    if (sizeClass >= PATH_BUFFER_SIZE_CLASSES)
+        return ::operator new(size);
+
+    {
+        std::lock_guard<std::mutex> lock(PathBufferLock);
+        std::vector<void*>& freeList = PathBufferFreeList[sizeClass];
+        if (!freeList.empty())
+        {
+            void* buffer = freeList.back();
+            freeList.pop_back();
+            return buffer;
+        }
+    }
+
+    return ::operator new(size_t(1) << (sizeClass + PATH_BUFFER_MIN_SIZE_SHIFT));
+}
+
+void PathBufferPool::Release(void* buffer, size_t size)
+{
+    if (!buffer)
+        return;
+
+    uint32 sizeClass = GetSizeClass(size);
+    if (sizeClass < PATH_BUFFER_SIZE_CLASSES)
+    {
+        std::lock_guard<std::mutex> lock(PathBufferLock);
+        std::vector<void*>& freeList = PathBufferFreeList[sizeClass];
+        if (freeList.size() < PATH_BUFFER_MAX_FREE)
+        {
+            freeList.push_back(buffer);
+            return;
+        }
+    }
+
+    ::operator delete(buffer);
+}
 
 ////////////////// PathGenerator //////////////////
+PathfindingStatistics PathGenerator::_statistics;
+
 PathGenerator::PathGenerator(const Unit* owner) :
-    _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
+    _pathPolyRefs(NULL), _polyLength(0), _maxPathLength(MAX_PATH_LENGTH),
+    _pointPathBuffer(NULL), _maxPointPathLength(MAX_POINT_PATH_LENGTH), _smoothPathStepSize(SMOOTH_PATH_STEP_SIZE),
+    _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _straightLine(false),
     _endPosition(G3D::Vector3::zero()), _sourceUnit(owner), _navMesh(NULL),
-    _navMeshQuery(NULL)
+    _navMeshQuery(NULL), _corridorEndPoly(INVALID_POLYREF)
 {
-    memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
+    AllocateBuffers();
+    memset(_corridorEndPoint, 0, sizeof(_corridorEndPoint));
 
     TC_LOG_DEBUG("maps", "++ PathGenerator::PathGenerator for %s", _sourceUnit->GetGUID().ToString().c_str());
 
@@ -52,6 +120,53 @@ PathGenerator::PathGenerator(const Unit* owner) :
 PathGenerator::~PathGenerator()
 {
     TC_LOG_DEBUG("maps", "++ PathGenerator::~PathGenerator() for %s", _sourceUnit->GetGUID().ToString().c_str());
+    FreeBuffers();
+}
+
+void PathGenerator::AllocateBuffers()
+{
+    if (_maxPathLength <= MAX_PATH_LENGTH)
+        _pathPolyRefs = _inlinePathPolyRefs;
+    else
+        _pathPolyRefs = static_cast<dtPolyRef*>(PathBufferPool::Acquire(2 * _maxPathLength * sizeof(dtPolyRef)));
+
+    if (_maxPointPathLength <= MAX_POINT_PATH_LENGTH)
+        _pointPathBuffer = _inlinePointPathBuffer;
+    else
+        _pointPathBuffer = static_cast<float*>(PathBufferPool::Acquire(_maxPointPathLength * VERTEX_SIZE * sizeof(float)));
+
+    memset(_pathPolyRefs, 0, _maxPathLength * sizeof(dtPolyRef));
+}
+
+void PathGenerator::FreeBuffers()
+{
+    if (_pathPolyRefs != _inlinePathPolyRefs)
+        PathBufferPool::Release(_pathPolyRefs, 2 * _maxPathLength * sizeof(dtPolyRef));
+
+    if (_pointPathBuffer != _inlinePointPathBuffer)
+        PathBufferPool::Release(_pointPathBuffer, _maxPointPathLength * VERTEX_SIZE * sizeof(float));
+
+    _pathPolyRefs = NULL;
+    _pointPathBuffer = NULL;
+}
+
+void PathGenerator::SetPathLimits(uint32 maxPathLength, uint32 maxPointPathLength)
+{
+    maxPathLength = std::min<uint32>(std::max<uint32>(maxPathLength, 2), MAX_PATH_LENGTH_LIMIT);
+    maxPointPathLength = std::min<uint32>(std::max<uint32>(maxPointPathLength, 2), MAX_POINT_PATH_LENGTH_LIMIT);
+
+    // an existing limit set by SetPathLengthLimit is kept as long as it still fits
+    if (_pointPathLimit == _maxPointPathLength || _pointPathLimit > maxPointPathLength)
+        _pointPathLimit = maxPointPathLength;
+
+    if (maxPathLength == _maxPathLength && maxPointPathLength == _maxPointPathLength)
+        return;
+
+    FreeBuffers();
+    _maxPathLength = maxPathLength;
+    _maxPointPathLength = maxPointPathLength;
+    AllocateBuffers();
+    Clear();
 }
 
 bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest, bool straightLine)
@@ -254,6 +369,8 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
         _pathPolyRefs[0] = startPoly;
         _polyLength = 1;
+        _corridorEndPoly = endPoly;
+        dtVcopy(_corridorEndPoint, endPoint);
 
         _type = farFromPoly ? PATHFIND_INCOMPLETE : PATHFIND_NORMAL;
         TC_LOG_DEBUG("maps", "++ BuildPolyPath :: path type %d\n", _type);
@@ -316,90 +433,107 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         // so we have atleast part of poly-path ready
 
         _polyLength -= pathStartIndex;
+        memmove(_pathPolyRefs, _pathPolyRefs + pathStartIndex, _polyLength * sizeof(dtPolyRef));
 
-        // try to adjust the suffix of the path instead of recalculating entire length
-        // at given interval the target cannot get too far from its last location
-        // thus we have less poly to cover
-        // sub-path of optimal path is optimal
+        // target usually moved only a few yards - walk the corridor end over to it
+        // the same way dtPathCorridor::moveTargetPosition does, no path search needed
+        if (!_straightLine && MoveCorridorEnd(endPoint, endPoly))
+        {
+            ++_statistics.CorridorPaths;
+            TC_LOG_DEBUG("maps", "++ BuildPolyPath :: corridor end moved, m_polyLength=%u\n", _polyLength);
+        }
+        else
+        {
+            ++_statistics.SuffixPaths;
 
-        // take ~80% of the original length
-        /// @todo play with the values here
-        uint32 prefixPolyLength = uint32(_polyLength * 0.8f + 0.5f);
-        memmove(_pathPolyRefs, _pathPolyRefs+pathStartIndex, prefixPolyLength * sizeof(dtPolyRef));
+            // try to adjust the suffix of the path instead of recalculating entire length
+            // at given interval the target cannot get too far from its last location
+            // thus we have less poly to cover
+            // sub-path of optimal path is optimal
 
-        dtPolyRef suffixStartPoly = _pathPolyRefs[prefixPolyLength-1];
+            // take ~80% of the original length
+            /// @todo play with the values here
+            uint32 prefixPolyLength = uint32(_polyLength * 0.8f + 0.5f);
 
-        // we need any point on our suffix start poly to generate poly-path, so we need last poly in prefix data
-        float suffixEndPoint[VERTEX_SIZE];
-        if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, NULL)))
-        {
-            // we can hit offmesh connection as last poly - closestPointOnPoly() don't like that
-            // try to recover by using prev polyref
-            --prefixPolyLength;
-            suffixStartPoly = _pathPolyRefs[prefixPolyLength-1];
+            dtPolyRef suffixStartPoly = _pathPolyRefs[prefixPolyLength-1];
+
+            // we need any point on our suffix start poly to generate poly-path, so we need last poly in prefix data
+            float suffixEndPoint[VERTEX_SIZE];
             if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, NULL)))
             {
-                // suffixStartPoly is still invalid, error state
-                BuildShortcut();
-                _type = PATHFIND_NOPATH;
-                return;
+                // we can hit offmesh connection as last poly - closestPointOnPoly() don't like that
+                // try to recover by using prev polyref
+                --prefixPolyLength;
+                suffixStartPoly = _pathPolyRefs[prefixPolyLength-1];
+                if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, NULL)))
+                {
+                    // suffixStartPoly is still invalid, error state
+                    BuildShortcut();
+                    _type = PATHFIND_NOPATH;
+                    return;
+                }
             }
-        }
-
-        // generate suffix
-        uint32 suffixPolyLength = 0;
 
-        dtStatus dtResult;
-        if (_straightLine)
-        {
-            float hit = 0;
-            float hitNormal[3];
-            memset(hitNormal, 0, sizeof(hitNormal));
-
-            dtResult = _navMeshQuery->raycast(
-                            suffixStartPoly,
-                            suffixEndPoint,
-                            endPoint,
-                            &_filter,
-                            &hit,
-                            hitNormal,
-                            _pathPolyRefs + prefixPolyLength - 1,
-                            (int*)&suffixPolyLength,
-                            MAX_PATH_LENGTH - prefixPolyLength);
+            // generate suffix
+            uint32 suffixPolyLength = 0;
 
-            // raycast() sets hit to FLT_MAX if there is a ray between start and end
-            if (hit != FLT_MAX)
+            dtStatus dtResult;
+            if (_straightLine)
             {
-                // the ray hit something, return no path instead of the incomplete one
-                _type = PATHFIND_NOPATH;
-                return;
+                float hit = 0;
+                float hitNormal[3];
+                memset(hitNormal, 0, sizeof(hitNormal));
+
+                dtResult = _navMeshQuery->raycast(
+                                suffixStartPoly,
+                                suffixEndPoint,
+                                endPoint,
+                                &_filter,
+                                &hit,
+                                hitNormal,
+                                _pathPolyRefs + prefixPolyLength - 1,
+                                (int*)&suffixPolyLength,
+                                _maxPathLength - prefixPolyLength);
+
+                // raycast() sets hit to FLT_MAX if there is a ray between start and end
+                if (hit != FLT_MAX)
+                {
+                    // the ray hit something, return no path instead of the incomplete one
+                    _type = PATHFIND_NOPATH;
+                    return;
+                }
+            }
+            else
+            {
+                dtResult = _navMeshQuery->findPath(
+                                suffixStartPoly,    // start polygon
+                                endPoly,            // end polygon
+                                suffixEndPoint,     // start position
+                                endPoint,           // end position
+                                &_filter,            // polygon search filter
+                                _pathPolyRefs + prefixPolyLength - 1,    // [out] path
+                                (int*)&suffixPolyLength,
+                                _maxPathLength - prefixPolyLength);   // max number of polygons in output path
             }
-        }
-        else
-        {
-            dtResult = _navMeshQuery->findPath(
-                            suffixStartPoly,    // start polygon
-                            endPoly,            // end polygon
-                            suffixEndPoint,     // start position
-                            endPoint,           // end position
-                            &_filter,            // polygon search filter
-                            _pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                            (int*)&suffixPolyLength,
-                            MAX_PATH_LENGTH - prefixPolyLength);   // max number of polygons in output path
-        }
 
-        if (!suffixPolyLength || dtStatusFailed(dtResult))
-        {
-            // this is probably an error state, but we'll leave it
-            // and hopefully recover on the next Update
-            // we still need to copy our preffix
-            TC_LOG_ERROR("maps", "%s's Path Build failed: 0 length path", _sourceUnit->GetGUID().ToString().c_str());
-        }
+            if (!suffixPolyLength || dtStatusFailed(dtResult))
+            {
+                // this is probably an error state, but we'll leave it
+                // and hopefully recover on the next Update
+                // we still need to copy our preffix
+                TC_LOG_ERROR("maps", "%s's Path Build failed: 0 length path", _sourceUnit->GetGUID().ToString().c_str());
+            }
 
-        TC_LOG_DEBUG("maps", "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u \n", _polyLength, prefixPolyLength, suffixPolyLength);
+            TC_LOG_DEBUG("maps", "++  m_polyLength=%u prefixPolyLength=%u suffixPolyLength=%u \n", _polyLength, prefixPolyLength, suffixPolyLength);
 
-        // new path = prefix + suffix - overlap
-        _polyLength = prefixPolyLength + suffixPolyLength - 1;
+            // new path = prefix + suffix - overlap
+            _polyLength = prefixPolyLength + suffixPolyLength - 1;
+        }
+    }
+    else if (!_straightLine && BuildSharedPolyPath(startPoly, endPoly))
+    {
+        TC_LOG_DEBUG("maps", "++ BuildPolyPath :: corridor shared, m_polyLength=%u\n", _polyLength);
+        ++_statistics.SharedPaths;
     }
     else
     {
@@ -411,6 +545,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
         // free and invalidate old path data
         Clear();
+        ++_statistics.FullPaths;
 
         dtStatus dtResult;
         if (_straightLine)
@@ -428,7 +563,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                             hitNormal,
                             _pathPolyRefs,
                             (int*)&_polyLength,
-                            MAX_PATH_LENGTH);
+                            _maxPathLength);
 
             // raycast() sets hit to FLT_MAX if there is a ray between start and end
             if (hit != FLT_MAX)
@@ -448,7 +583,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
                             &_filter,           // polygon search filter
                             _pathPolyRefs,     // [out] path
                             (int*)&_polyLength,
-                            MAX_PATH_LENGTH);   // max number of polygons in output path
+                            _maxPathLength);   // max number of polygons in output path
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -467,13 +602,95 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     else
         _type = PATHFIND_INCOMPLETE;
 
+    // remember where the corridor ends so the next request can patch it instead of searching again
+    _corridorEndPoly = _pathPolyRefs[_polyLength - 1] == endPoly ? endPoly : INVALID_POLYREF;
+    dtVcopy(_corridorEndPoint, endPoint);
+
     // generate the point-path out of our up-to-date poly-path
     BuildPointPath(startPoint, endPoint);
 }
 
+bool PathGenerator::MoveCorridorEnd(float const* endPoint, dtPolyRef endPoly)
+{
+    if (!_polyLength || _corridorEndPoly == INVALID_POLYREF || _pathPolyRefs[_polyLength - 1] != _corridorEndPoly)
+        return false;
+
+    if (dtVdist2DSqr(_corridorEndPoint, endPoint) > CORRIDOR_MAX_END_MOVE * CORRIDOR_MAX_END_MOVE)
+        return false;
+
+    float resultPos[VERTEX_SIZE];
+    dtPolyRef visited[CORRIDOR_MAX_VISITED];
+    int visitedCount = 0;
+    dtStatus dtResult = _navMeshQuery->moveAlongSurface(_corridorEndPoly, _corridorEndPoint, endPoint, &_filter,
+        resultPos, visited, &visitedCount, CORRIDOR_MAX_VISITED);
+
+    // the surface walk must end up exactly on the new end poly, otherwise something is in the way
+    if (dtStatusFailed(dtResult) || !visitedCount || visited[visitedCount - 1] != endPoly)
+        return false;
+
+    // find the furthest polygon the corridor and the walk have in common (dtMergeCorridorEndMoved)
+    int32 furthestPath = -1;
+    int32 furthestVisited = -1;
+    for (int32 i = int32(_polyLength) - 1; i >= 0 && furthestPath == -1; --i)
+    {
+        for (int32 j = visitedCount - 1; j >= 0; --j)
+        {
+            if (_pathPolyRefs[i] == visited[j])
+            {
+                furthestPath = i;
+                furthestVisited = j;
+                break;
+            }
+        }
+    }
+
+    if (furthestPath == -1 || furthestVisited == -1)
+        return false;
+
+    // cut the corridor after the common polygon and append the visited ones
+    uint32 count = uint32(visitedCount - (furthestVisited + 1));
+    if (uint32(furthestPath + 1) + count > _maxPathLength)
+        return false;
+
+    memcpy(_pathPolyRefs + furthestPath + 1, visited + furthestVisited + 1, count * sizeof(dtPolyRef));
+    _polyLength = uint32(furthestPath + 1) + count;
+    return true;
+}
+
+bool PathGenerator::BuildSharedPolyPath(dtPolyRef startPoly, dtPolyRef endPoly)
+{
+    for (PathGenerator const* other : _sharedPaths)
+    {
+        // corridor must be complete, up to date and on the same map instance
+        if (other == this || other->_navMeshQuery != _navMeshQuery || other->_type != PATHFIND_NORMAL ||
+            other->_polyLength < 2 || other->_corridorEndPoly != endPoly || other->_pathPolyRefs[other->_polyLength - 1] != endPoly)
+            continue;
+
+        // corridor may cross polygons this unit cannot walk (water, magma...) or avoid ones it can
+        if (other->_filter.getIncludeFlags() != _filter.getIncludeFlags() || other->_filter.getExcludeFlags() != _filter.getExcludeFlags())
+            continue;
+
+        // sub-path of optimal path is optimal, as long as we start somewhere on it
+        for (uint32 i = 0; i < other->_polyLength; ++i)
+        {
+            if (other->_pathPolyRefs[i] != startPoly)
+                continue;
+
+            if (other->_polyLength - i > _maxPathLength)
+                break;
+
+            _polyLength = other->_polyLength - i;
+            memcpy(_pathPolyRefs, other->_pathPolyRefs + i, _polyLength * sizeof(dtPolyRef));
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoint)
 {
-    float pathPoints[MAX_POINT_PATH_LENGTH*VERTEX_SIZE];
+    float* pathPoints = _pointPathBuffer;
     uint32 pointCount = 0;
     dtStatus dtResult = DT_FAILURE;
     if (_straightLine)
@@ -482,16 +699,17 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
         pointCount = 1;
         memcpy(&pathPoints[VERTEX_SIZE * 0], startPoint, sizeof(float)* 3); // first point
 
-        // path has to be split into polygons with dist SMOOTH_PATH_STEP_SIZE between them
+        // path has to be split into polygons with dist _smoothPathStepSize between them
         G3D::Vector3 startVec = G3D::Vector3(startPoint[0], startPoint[1], startPoint[2]);
         G3D::Vector3 endVec = G3D::Vector3(endPoint[0], endPoint[1], endPoint[2]);
         G3D::Vector3 diffVec = (endVec - startVec);
         G3D::Vector3 prevVec = startVec;
         float len = diffVec.length();
-        diffVec *= SMOOTH_PATH_STEP_SIZE / len;
-        while (len > SMOOTH_PATH_STEP_SIZE)
+        diffVec *= _smoothPathStepSize / len;
+        // stop one point before the limit, the path is then reported as PATHFIND_SHORT below
+        while (len > _smoothPathStepSize && pointCount + 1 < _pointPathLimit)
         {
-            len -= SMOOTH_PATH_STEP_SIZE;
+            len -= _smoothPathStepSize;
             prevVec += diffVec;
             pathPoints[VERTEX_SIZE * pointCount + 0] = prevVec.x;
             pathPoints[VERTEX_SIZE * pointCount + 1] = prevVec.y;
@@ -540,6 +758,7 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
     else if (pointCount == _pointPathLimit)
     {
         TC_LOG_DEBUG("maps", "++ PathGenerator::BuildPointPath FAILED! path sized %d returned, lower than limit set to %d\n", pointCount, _pointPathLimit);
+        ++_statistics.LimitedPaths;
         BuildShortcut();
         _type = PATHFIND_SHORT;
         return;
@@ -768,7 +987,8 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
     *smoothPathSize = 0;
     uint32 nsmoothPath = 0;
 
-    dtPolyRef polys[MAX_PATH_LENGTH];
+    // second half of the poly path buffer is our working corridor
+    dtPolyRef* polys = _pathPolyRefs + _maxPathLength;
     memcpy(polys, polyPath, sizeof(dtPolyRef)*polyPathSize);
     uint32 npolys = polyPathSize;
 
@@ -802,10 +1022,10 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
         dtVsub(delta, steerPos, iterPos);
         float len = dtSqrt(dtVdot(delta, delta));
         // If the steer target is end of path or off-mesh link, do not move past the location.
-        if ((endOfPath || offMeshConnection) && len < SMOOTH_PATH_STEP_SIZE)
+        if ((endOfPath || offMeshConnection) && len < _smoothPathStepSize)
             len = 1.0f;
         else
-            len = SMOOTH_PATH_STEP_SIZE / len;
+            len = _smoothPathStepSize / len;
 
         float moveTgt[VERTEX_SIZE];
         dtVmad(moveTgt, iterPos, delta, len);
@@ -817,7 +1037,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
 
         uint32 nvisited = 0;
         _navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, &_filter, result, visited, (int*)&nvisited, MAX_VISIT_POLY);
-        npolys = FixupCorridor(polys, npolys, MAX_PATH_LENGTH, visited, nvisited);
+        npolys = FixupCorridor(polys, npolys, _maxPathLength, visited, nvisited);
 
         _navMeshQuery->getPolyHeight(polys[0], result, &result[1]);
         result[1] += 0.5f;
@@ -880,7 +1100,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
     *smoothPathSize = nsmoothPath;
 
     // this is most likely a loop
-    return nsmoothPath < MAX_POINT_PATH_LENGTH ? DT_SUCCESS : DT_FAILURE;
+    return nsmoothPath < _maxPointPathLength ? DT_SUCCESS : DT_FAILURE;
 }
 
 bool PathGenerator::InRangeYZX(const float* v1, const float* v2, float r, float h) const
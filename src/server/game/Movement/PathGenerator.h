@@ -23,21 +23,32 @@
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
 #include "MoveSplineInitArgs.h"
+#include <atomic>
 
 class Unit;
 
+// default limits, can be raised per request with PathGenerator::SetPathLimits
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
 // I think we can safely cut those down even more
 #define MAX_PATH_LENGTH         74
 #define MAX_POINT_PATH_LENGTH   74
 
+// hard upper bounds for SetPathLimits, 1024*4.0f=4096y
+#define MAX_PATH_LENGTH_LIMIT        1024
+#define MAX_POINT_PATH_LENGTH_LIMIT  1024
+
 #define SMOOTH_PATH_STEP_SIZE   4.0f
 #define SMOOTH_PATH_SLOP        0.3f
 
 #define VERTEX_SIZE       3
 #define INVALID_POLYREF   0
 
+// how far the destination may move before the corridor end is no longer
+// patched with a surface walk and a new suffix path is searched instead
+#define CORRIDOR_MAX_END_MOVE   10.0f
+#define CORRIDOR_MAX_VISITED    16
+
 enum PathType
 {
     PATHFIND_BLANK          = 0x00,   // path not built yet
@@ -49,19 +60,49 @@ enum PathType
     PATHFIND_SHORT          = 0x20,   // path is longer or equal to its limited path length
 };
 
+// counters of how paths were produced, shared by all generators
+struct PathfindingStatistics
+{
+    std::atomic<uint64> FullPaths;      // findPath over the whole distance
+    std::atomic<uint64> SuffixPaths;    // prefix of the old corridor kept, findPath for the rest
+    std::atomic<uint64> CorridorPaths;  // corridor end moved along the surface, no findPath
+    std::atomic<uint64> SharedPaths;    // corridor copied from another unit heading to the same place
+    std::atomic<uint64> LimitedPaths;   // point path hit its length limit and was replaced by a shortcut
+};
+
+// size-classed buffers for poly and point paths raised above the default limits,
+// recycled between generators so that long paths do not hit the heap every time.
+// Paths within the default limits use the inline buffers of PathGenerator and never lock the pool.
+class PathBufferPool
+{
+    public:
+        static void* Acquire(size_t size);
+        static void Release(void* buffer, size_t size);
+
+    private:
+        static uint32 GetSizeClass(size_t size);
+};
+
 class PathGenerator
 {
     public:
         explicit PathGenerator(Unit const* owner);
         ~PathGenerator();
 
+        PathGenerator(PathGenerator const&) = delete;
+        PathGenerator& operator=(PathGenerator const&) = delete;
+
         // Calculate the path from owner to given destination
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false, bool straightLine = false);
 
         // option setters - use optional
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
-        void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); }
+        void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/_smoothPathStepSize), _maxPointPathLength); }
+        // capacity of the poly and point paths, clamped to MAX_PATH_LENGTH_LIMIT/MAX_POINT_PATH_LENGTH_LIMIT
+        // drops the current corridor, so it is meant to be called before CalculatePath
+        void SetPathLimits(uint32 maxPathLength, uint32 maxPointPathLength);
+        void SetSmoothPathStepSize(float stepSize) { _smoothPathStepSize = std::max(stepSize, SMOOTH_PATH_SLOP * 2); }
 
         // result getters
         G3D::Vector3 const& GetStartPosition() const { return _startPosition; }
@@ -74,17 +115,34 @@ class PathGenerator
 
         void ReducePathLenghtByDist(float dist); // path must be already built
 
+        // corridors of other units moving to the same destination (e.g. pursuers of one target)
+        // a full path search is skipped when one of them already passes through our start polygon
+        void ClearSharedPaths() { _sharedPaths.clear(); }
+        void AddSharedPath(PathGenerator const* path) { _sharedPaths.push_back(path); }
+
+        static PathfindingStatistics const& GetStatistics() { return _statistics; }
+
     private:
 
-        dtPolyRef _pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
-        uint32 _polyLength;                         // number of polygons in the path
+        dtPolyRef* _pathPolyRefs;   // array of detour polygon references, followed by the same amount of scratch space for FindSmoothPath
+        uint32 _polyLength;         // number of polygons in the path
+        uint32 _maxPathLength;      // capacity of _pathPolyRefs
+
+        float* _pointPathBuffer;        // detour point path before conversion to _pathPoints
+        uint32 _maxPointPathLength;     // capacity of _pointPathBuffer in points
+
+        // used while the limits stay at their defaults, which is the case for nearly every generator
+        dtPolyRef _inlinePathPolyRefs[2 * MAX_PATH_LENGTH];
+        float _inlinePointPathBuffer[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
+
+        float _smoothPathStepSize;      // distance between two points of a smooth path
 
         Movement::PointsArray _pathPoints;  // our actual (x,y,z) path to the target
         PathType _type;                     // tells what kind of path this is
 
         bool _useStraightPath;  // type of path will be generated
         bool _forceDestination; // when set, we will always arrive at given point
-        uint32 _pointPathLimit; // limit point path size; min(this, MAX_POINT_PATH_LENGTH)
+        uint32 _pointPathLimit; // limit point path size; min(this, _maxPointPathLength)
         bool _straightLine;     // use raycast if true for a straight line path
 
         G3D::Vector3 _startPosition;        // {x, y, z} of current location
@@ -97,14 +155,23 @@ class PathGenerator
 
         dtQueryFilter _filter;  // use single filter for all movements, update it when needed
 
+        float _corridorEndPoint[VERTEX_SIZE];           // destination the current poly path was built for
+        dtPolyRef _corridorEndPoly;                     // polygon of that destination, INVALID_POLYREF if the path does not reach it
+        std::vector<PathGenerator const*> _sharedPaths; // candidates for BuildSharedPolyPath
+
+        static PathfindingStatistics _statistics;
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
         void NormalizePath();
+        void AllocateBuffers();
+        void FreeBuffers();
 
         void Clear()
         {
             _polyLength = 0;
+            _corridorEndPoly = INVALID_POLYREF;
             _pathPoints.clear();
         }
 
@@ -117,6 +184,8 @@ class PathGenerator
         bool HaveTile(G3D::Vector3 const& p) const;
 
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
+        bool MoveCorridorEnd(float const* endPoint, dtPolyRef endPoly);
+        bool BuildSharedPolyPath(dtPolyRef startPoly, dtPolyRef endPoly);
         void BuildPointPath(float const* startPoint, float const* endPoint);
         void BuildShortcut();
 
@@ -211,6 +211,12 @@ namespace Movement
         if (generatePath)
         {
             PathGenerator path(unit);
+            // long point movement (escorts, scripted flights) does not fit into the default limits
+            // and would fall back to a shortcut, give the path room for detours around obstacles
+            uint32 pointPathLength = uint32(unit->GetExactDist(dest.x, dest.y, dest.z) * 2.0f / SMOOTH_PATH_STEP_SIZE);
+            if (pointPathLength > MAX_POINT_PATH_LENGTH)
+                path.SetPathLimits(pointPathLength, pointPathLength);
+
             bool result = path.CalculatePath(dest.x, dest.y, dest.z, forceDestination);
             if (result && !(path.GetPathType() & PATHFIND_NOPATH))
             {
@@ -115,10 +115,7 @@ ByteBuffer& operator<<(ByteBuffer& data, WorldPackets::Query::PlayerGuidLookupHi
 
 bool WorldPackets::Query::PlayerGuidLookupData::Initialize(ObjectGuid const& guid, Player const* player /*= nullptr*/)
 {
-    CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(guid);
-    if (!characterInfo)
-        return false;
-
+    // online players are always answered from the Player object, their cache entry may have been evicted
     if (player)
     {
         ASSERT(player->GetGUID() == guid);
@@ -133,22 +130,28 @@ bool WorldPackets::Query::PlayerGuidLookupData::Initialize(ObjectGuid const& gui
 
         if (DeclinedName const* names = player->GetDeclinedNames())
             DeclinedNames = *names;
+
+        IsDeleted = false;
     }
     else
     {
+        CharacterInfo characterInfo;
+        if (!sWorld->GetCharacterInfo(guid, characterInfo))
+            return false;
+
         uint32 accountId = ObjectMgr::GetPlayerAccountIdByGUID(guid);
         uint32 bnetAccountId = Battlenet::AccountMgr::GetIdByGameAccount(accountId);
 
         AccountID     = ObjectGuid::Create<HighGuid::WowAccount>(accountId);
         BnetAccountID = ObjectGuid::Create<HighGuid::BNetAccount>(bnetAccountId);
-        Name          = characterInfo->Name;
-        Race          = characterInfo->Race;
-        Sex           = characterInfo->Sex;
-        ClassID       = characterInfo->Class;
-        Level         = characterInfo->Level;
+        Name          = characterInfo.Name;
+        Race          = characterInfo.Race;
+        Sex           = characterInfo.Sex;
+        ClassID       = characterInfo.Class;
+        Level         = characterInfo.Level;
+        IsDeleted     = characterInfo.IsDeleted;
     }
 
-    IsDeleted = characterInfo->IsDeleted;
     GuidActual = guid;
     VirtualRealmAddress = GetVirtualRealmAddress();
 
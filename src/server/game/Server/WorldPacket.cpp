@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldPacket.h"
+
+namespace
+{
+    OpcodeAllocationStatistics opcodeStatistics[NUM_OPCODE_HANDLERS];
+}
+
+OpcodeAllocationStatistics const* WorldPacket::GetOpcodeStatistics(uint32 opcode)
+{
+    if (opcode >= NUM_OPCODE_HANDLERS)
+        return NULL;
+
+    return &opcodeStatistics[opcode];
+}
+
+void WorldPacket::ReserveForOpcode(size_t res)
+{
+    if (m_opcode >= NUM_OPCODE_HANDLERS)
+    {
+        AcquireStorage(res);
+        return;
+    }
+
+    OpcodeAllocationStatistics& stats = opcodeStatistics[m_opcode];
+    ++stats.Created;
+
+    // reserve what packets with this opcode needed before to avoid growing the storage while writing
+    size_t reserve = std::max<size_t>(res, stats.LearnedSize.load(std::memory_order_relaxed));
+    if (reserve && !AcquireStorage(reserve))
+        ++stats.Allocated;
+}
+
+void WorldPacket::RecordSent(WorldPacket const& packet)
+{
+    if (packet.GetOpcode() >= NUM_OPCODE_HANDLERS)
+        return;
+
+    OpcodeAllocationStatistics& stats = opcodeStatistics[packet.GetOpcode()];
+    ++stats.Sent;
+    stats.SentBytes += packet.size();
+
+    size_t sentSize = packet.size();
+    if (sentSize > MaxLearnedSize)
+        sentSize = MaxLearnedSize;
+
+    // moves quickly towards larger sizes and slowly towards smaller ones, so the reserve covers most packets
+    // of the opcode while a single oversized packet is forgotten again after a few dozen normal ones
+    uint32 size = uint32(sentSize);
+    uint32 learned = stats.LearnedSize.load(std::memory_order_relaxed);
+    uint32 updated;
+    do
+    {
+        if (size > learned)
+            updated = learned + (size - learned + 3) / 4;
+        else
+            updated = learned - (learned - size) / 32;
+    } while (updated != learned && !stats.LearnedSize.compare_exchange_weak(learned, updated, std::memory_order_relaxed));
+}
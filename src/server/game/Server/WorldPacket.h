@@ -23,16 +23,32 @@
 #include "Opcodes.h"
 #include "ByteBuffer.h"
 
+// Allocation and size counters of packets with one opcode, shared by all threads
+struct OpcodeAllocationStatistics
+{
+    std::atomic<uint64> Created;
+    std::atomic<uint64> Allocated;                          // created without reusing pooled storage
+    std::atomic<uint64> Sent;
+    std::atomic<uint64> SentBytes;
+    std::atomic<uint32> LearnedSize;                        // decaying average of sent sizes biased towards large ones, used as reserve for new packets
+};
+
 class WorldPacket : public ByteBuffer
 {
     public:
+        // Learned reserve sizes are capped, larger packets grow their storage as before
+        static size_t const MaxLearnedSize = ByteBuffer::DEFAULT_SIZE * 4;
+
                                                             // just container for later use
         WorldPacket() : ByteBuffer(0), m_opcode(UNKNOWN_OPCODE), _connection(CONNECTION_TYPE_DEFAULT)
         {
         }
 
-        WorldPacket(uint32 opcode, size_t res = 200, ConnectionType connection = CONNECTION_TYPE_DEFAULT) : ByteBuffer(res),
-            m_opcode(opcode), _connection(connection) { }
+        WorldPacket(uint32 opcode, size_t res = 200, ConnectionType connection = CONNECTION_TYPE_DEFAULT) : ByteBuffer(0),
+            m_opcode(opcode), _connection(connection)
+        {
+            ReserveForOpcode(res);
+        }
 
         WorldPacket(WorldPacket&& packet) : ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode), _connection(packet._connection)
         {
@@ -81,7 +97,12 @@ class WorldPacket : public ByteBuffer
 
         ConnectionType GetConnection() const { return _connection; }
 
+        static OpcodeAllocationStatistics const* GetOpcodeStatistics(uint32 opcode);
+        static void RecordSent(WorldPacket const& packet);
+
     protected:
+        void ReserveForOpcode(size_t res);
+
         uint32 m_opcode;
         ConnectionType _connection;
 };
@@ -373,6 +373,8 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
 
+    WorldPacket::RecordSent(packet);
+
     uint32 packetSize = packet.size();
     uint32 sizeOfHeader = SizeOfServerHeader[_authCrypt.IsInitialized()];
     if (packetSize > 0x400)
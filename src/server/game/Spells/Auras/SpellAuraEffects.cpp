@@ -726,6 +726,8 @@ int32 AuraEffect::CalculateAmount(Unit* caster)
 
 void AuraEffect::CalculatePeriodic(Unit* caster, bool resetPeriodicTimer /*= true*/, bool load /*= false*/)
 {
+    // a sleeping aura must not miss the first tick of an effect becoming periodic
+    GetBase()->WakeUp();
     m_period = GetSpellEffectInfo()->ApplyAuraPeriod;
 
     // prepare periodics
@@ -827,6 +829,20 @@ void AuraEffect::CalculateSpellMod()
     GetBase()->CallScriptEffectCalcSpellModHandlers(this, m_spellmod);
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    m_amount = amount;
+    m_canBeRecalculated = false;
+    InvalidateTargetAuraTotals();
+}
+
+void AuraEffect::InvalidateTargetAuraTotals()
+{
+    // cached modifier totals of every target this effect is registered on depend on m_amount
+    for (Aura::ApplicationMap::value_type const& application : GetBase()->GetApplicationMap())
+        application.second->GetTarget()->InvalidateAuraTypeTotals(GetAuraType());
+}
+
 void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
 {
     // Reapply if amount change
@@ -849,7 +865,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetAuraTotals();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
@@ -53,10 +53,10 @@ class AuraEffect
         int32 GetMiscValue() const { return GetSpellEffectInfo()->MiscValue; }
         AuraType GetAuraType() const { return (AuraType)GetSpellEffectInfo()->ApplyAuraName; }
         int32 GetAmount() const { return m_amount; }
-        void SetAmount(int32 amount) { m_amount = amount; m_canBeRecalculated = false;}
+        void SetAmount(int32 amount);
 
-        int32 GetPeriodicTimer() const { return m_periodicTimer; }
-        void SetPeriodicTimer(int32 periodicTimer) { m_periodicTimer = periodicTimer; }
+        int32 GetPeriodicTimer() const { return m_periodicTimer - GetBase()->GetSleepingTime(); }
+        void SetPeriodicTimer(int32 periodicTimer) { GetBase()->WakeUp(); m_periodicTimer = periodicTimer; }
 
         int32 CalculateAmount(Unit* caster);
         void CalculatePeriodic(Unit* caster, bool resetPeriodicTimer = true, bool load = false);
@@ -82,10 +82,10 @@ class AuraEffect
 
         uint32 GetTickNumber() const { return m_tickNumber; }
         int32 GetTotalTicks() const { return m_period ? (GetBase()->GetMaxDuration() / m_period) : 1;}
-        void ResetPeriodic(bool resetPeriodicTimer = false) { if (resetPeriodicTimer) m_periodicTimer = m_period; m_tickNumber = 0;}
+        void ResetPeriodic(bool resetPeriodicTimer = false) { GetBase()->WakeUp(); if (resetPeriodicTimer) m_periodicTimer = m_period; m_tickNumber = 0;}
 
         bool IsPeriodic() const { return m_isPeriodic; }
-        void SetPeriodic(bool isPeriodic) { m_isPeriodic = isPeriodic; }
+        void SetPeriodic(bool isPeriodic) { GetBase()->WakeUp(); m_isPeriodic = isPeriodic; }
         bool IsAffectingSpell(SpellInfo const* spell) const;
         bool HasSpellClassMask() const { return GetSpellEffectInfo()->SpellClassMask; }
 
@@ -106,6 +106,8 @@ class AuraEffect
         bool IsAreaAuraEffect() const;
 
     private:
+        void InvalidateTargetAuraTotals();
+
         Aura* const m_base;
 
         SpellInfo const* const m_spellInfo;
@@ -359,10 +359,13 @@ Aura* Aura::Create(SpellInfo const* spellproto, uint32 effMask, WorldObject* own
     return aura;
 }
 
+AuraUpdateStatistics Aura::_updateStatistics;
+
 Aura::Aura(SpellInfo const* spellproto, WorldObject* owner, Unit* caster, Item* castItem, ObjectGuid casterGUID) :
 m_spellInfo(spellproto), m_casterGuid(!casterGUID.IsEmpty() ? casterGUID : caster->GetGUID()),
 m_castItemGuid(castItem ? castItem->GetGUID() : ObjectGuid::Empty), m_applyTime(time(NULL)),
 m_owner(owner), m_timeCla(0), m_updateTargetMapInterval(0),
+m_lastUpdateClock(owner->ToUnit() ? owner->ToUnit()->GetAuraUpdateClock() : 0), m_wakeUpClock(0), m_isSleeping(false),
 m_casterLevel(caster ? caster->getLevel() : m_spellInfo->SpellLevel), m_procCharges(0), m_stackAmount(1),
 m_isRemoved(false), m_isSingleTarget(false), m_isUsingCharges(false), m_dropEvent(nullptr)
 {
@@ -529,6 +532,8 @@ void Aura::UpdateTargetMap(Unit* caster, bool apply)
     if (IsRemoved())
         return;
 
+    WakeUp();
+
     m_updateTargetMapInterval = UPDATE_TARGET_MAP_INTERVAL;
 
     // fill up to date target list
@@ -724,6 +729,91 @@ void Aura::UpdateOwner(uint32 diff, WorldObject* owner)
     _DeleteRemovedApplications();
 }
 
+uint32 Aura::PrepareOwnerUpdate(uint32 updateClock)
+{
+    // auras woken up earlier in this update already had the elapsed time applied
+    uint32 diff = updateClock - m_lastUpdateClock;
+    m_lastUpdateClock = updateClock;
+    m_isSleeping = false;
+    return diff;
+}
+
+void Aura::TrySleep()
+{
+    if (IsRemoved() || GetType() != UNIT_AURA_TYPE || !m_duration)
+        return;
+
+    int32 sleepTime = m_updateTargetMapInterval;
+    if (m_duration > 0)
+    {
+        sleepTime = std::min(sleepTime, m_duration);
+        if (m_timeCla)
+            sleepTime = std::min(sleepTime, m_timeCla);
+    }
+
+    if (m_duration >= 0 || IsPassive() || IsPermanent())
+        for (AuraEffect* effect : GetAuraEffects())
+            if (effect && effect->IsPeriodic())
+                sleepTime = std::min(sleepTime, effect->GetPeriodicTimer());
+
+    if (sleepTime <= 0)
+        return;
+
+    m_wakeUpClock = m_lastUpdateClock + sleepTime;
+    m_isSleeping = true;
+}
+
+void Aura::WakeUp()
+{
+    if (!m_isSleeping)
+        return;
+
+    // no deadline has passed yet, so only the timers need to catch up
+    int32 elapsed = GetSleepingTime();
+    m_lastUpdateClock += elapsed;
+    m_isSleeping = false;
+
+    // the aura must be marked awake before touching periodic timers, their accessors account for sleeping time
+    if (m_duration >= 0 || IsPassive() || IsPermanent())
+        for (AuraEffect* effect : GetAuraEffects())
+            if (effect && effect->IsPeriodic())
+                effect->SetPeriodicTimer(effect->GetPeriodicTimer() - elapsed);
+
+    if (m_duration > 0)
+    {
+        m_duration = std::max(m_duration - elapsed, 0);
+        if (m_timeCla)
+            m_timeCla -= elapsed;
+    }
+
+    m_updateTargetMapInterval = std::max(m_updateTargetMapInterval - elapsed, 0);
+    ++_updateStatistics.WokenUp;
+}
+
+int32 Aura::GetSleepingTime() const
+{
+    if (!m_isSleeping)
+        return 0;
+
+    return int32(GetUnitOwner()->GetAuraUpdateClock() - m_lastUpdateClock);
+}
+
+int32 Aura::GetSleepingDuration() const
+{
+    if (m_duration <= 0)
+        return m_duration;
+
+    return std::max(m_duration - GetSleepingTime(), 0);
+}
+
+void Aura::RecordOwnerUpdates(uint32 updated, uint32 skipped)
+{
+    if (updated)
+        _updateStatistics.Updated += updated;
+    if (skipped)
+        _updateStatistics.Skipped += skipped;
+}
+
 void Aura::Update(uint32 diff, Unit* caster)
 {
     if (m_duration > 0)
@@ -806,6 +896,7 @@ void Aura::SetDuration(int32 duration, bool withMods)
             if (Player* modOwner = caster->GetSpellModOwner())
                 modOwner->ApplySpellMod(GetId(), SPELLMOD_DURATION, duration);
 
+    WakeUp();
     m_duration = duration;
     SetNeedClientUpdateForTargets();
 }
@@ -832,6 +923,7 @@ void Aura::RefreshDuration(bool withMods)
 
 void Aura::RefreshTimers()
 {
+    WakeUp();
     m_maxDuration = CalcMaxDuration();
     bool resetPeriodic = true;
     if (m_spellInfo->HasAttribute(SPELL_ATTR8_DONT_RESET_PERIODIC_TIMER))
@@ -1160,6 +1252,7 @@ AuraKey Aura::GenerateKey(uint32& recalculateMask) const
 
 void Aura::SetLoadedState(int32 maxDuration, int32 duration, int32 charges, uint8 stackAmount, uint32 recalculateMask, int32* amount)
 {
+    WakeUp();
     m_maxDuration = maxDuration;
     m_duration = duration;
     m_procCharges = charges;
@@ -1866,7 +1959,7 @@ bool Aura::IsProcTriggeredOnEvent(AuraApplication* aurApp, ProcEventInfo& eventI
         return false;
 
     // do checks using conditions table
-    ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, GetId());
+    ConditionSpan conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, GetId());
     ConditionSourceInfo condInfo = ConditionSourceInfo(eventInfo.GetActor(), eventInfo.GetActionTarget());
     if (!sConditionMgr->IsObjectMeetToConditions(condInfo, conditions))
         return false;
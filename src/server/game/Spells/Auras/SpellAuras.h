@@ -22,6 +22,7 @@
 #include "SpellAuraDefines.h"
 #include "SpellInfo.h"
 #include "Unit.h"
+#include <atomic>
 
 class SpellInfo;
 struct SpellModifier;
@@ -113,6 +114,14 @@ struct AuraLoadEffectInfo
 };
 #pragma pack(pop)
 
+// Counters of owner updates done and skipped by Unit::_UpdateSpells, shared by all maps
+struct AuraUpdateStatistics
+{
+    std::atomic<uint64> Updated;
+    std::atomic<uint64> Skipped;
+    std::atomic<uint64> WokenUp;                            // sleeping auras caught up early by a timer change
+};
+
 class Aura
 {
     friend Aura* Unit::_TryStackingOrRefreshingExistingAura(SpellInfo const* newAura, uint32 effMask, Unit* caster, int32 *baseAmount, Item* castItem, ObjectGuid casterGUID);
@@ -154,12 +163,24 @@ class Aura
         void UpdateOwner(uint32 diff, WorldObject* owner);
         void Update(uint32 diff, Unit* caster);
 
+        // Owner update scheduling - unit auras are only updated by Unit::_UpdateSpells when a periodic tick,
+        // periodic cost, expiration or target map refresh is due, elapsed time is applied on wake up
+        bool IsSleeping() const { return m_isSleeping; }
+        bool IsWakeUpDue(uint32 updateClock) const { return int32(updateClock - m_wakeUpClock) >= 0; }
+        int32 GetSleepingTime() const;
+        uint32 PrepareOwnerUpdate(uint32 updateClock);
+        void TrySleep();
+        void WakeUp();
+
+        static AuraUpdateStatistics const& GetUpdateStatistics() { return _updateStatistics; }
+        static void RecordOwnerUpdates(uint32 updated, uint32 skipped);
+
         time_t GetApplyTime() const { return m_applyTime; }
         int32 GetMaxDuration() const { return m_maxDuration; }
         void SetMaxDuration(int32 duration) { m_maxDuration = duration; }
         int32 CalcMaxDuration() const { return CalcMaxDuration(GetCaster()); }
         int32 CalcMaxDuration(Unit* caster) const;
-        int32 GetDuration() const { return m_duration; }
+        int32 GetDuration() const { return m_isSleeping ? GetSleepingDuration() : m_duration; }
         void SetDuration(int32 duration, bool withMods = false);
         void RefreshDuration(bool withMods = false);
         void RefreshTimers();
@@ -284,13 +305,14 @@ class Aura
 
         std::list<AuraScript*> m_loadedScripts;
 
-        AuraEffectVector GetAuraEffects() const { return _effects; }
+        AuraEffectVector const& GetAuraEffects() const { return _effects; }
 
         SpellEffectInfoVector GetSpellEffectInfos() const { return _spelEffectInfos; }
         SpellEffectInfo const* GetSpellEffectInfo(uint32 index) const;
 
     private:
         void _DeleteRemovedApplications();
+        int32 GetSleepingDuration() const;
     protected:
         SpellInfo const* const m_spellInfo;
         ObjectGuid const m_casterGuid;
@@ -303,6 +325,9 @@ class Aura
         int32 m_timeCla;                                    // Timer for power per sec calcultion
         std::vector<SpellPowerEntry const*> m_periodicCosts;// Periodic costs
         int32 m_updateTargetMapInterval;                    // Timer for UpdateTargetMapOfEffect
+        uint32 m_lastUpdateClock;                           // Owner aura clock at last update (unit owned auras only)
+        uint32 m_wakeUpClock;                               // Owner aura clock at which a sleeping aura must be updated
+        bool m_isSleeping;
 
         uint8 const m_casterLevel;                          // Aura level (store caster level for correct show level dep amount)
         uint8 m_procCharges;                                // Aura charges (0 for infinite)
@@ -322,6 +347,8 @@ class Aura
 
         AuraEffectVector _effects;
         SpellEffectInfoVector _spelEffectInfos;
+
+        static AuraUpdateStatistics _updateStatistics;
 };
 
 class UnitAura : public Aura
@@ -467,7 +467,7 @@ int32 GetDiminishingReturnsLimitDuration(SpellInfo const* spellproto)
     return 8 * IN_MILLISECONDS;
 }
 
-SpellMgr::SpellMgr() { }
+SpellMgr::SpellMgr() : _spellGroupDataVersion(0), _procDataVersion(0) { }
 
 SpellMgr::~SpellMgr()
 {
@@ -833,6 +833,19 @@ SpellProcEventEntry const* SpellMgr::GetSpellProcEvent(uint32 spellId) const
     return NULL;
 }
 
+uint32 SpellMgr::GetSpellProcEventFlags(SpellInfo const* spellInfo) const
+{
+    // auras with spell_proc entry are handled by new proc system
+    if (GetSpellProcEntry(spellInfo->Id))
+        return 0;
+
+    SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellInfo->Id);
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+
+    return spellInfo->ProcFlags;
+}
+
 bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active) const
 {
     // No extra req need
@@ -1781,6 +1794,7 @@ void SpellMgr::LoadSpellGroups()
 
     mSpellSpellGroup.clear();                                  // need for reload case
     mSpellGroupSpell.clear();
+    ++_spellGroupDataVersion;                                  // units drop their cached aura type totals
 
     //                                                0     1
     QueryResult result = WorldDatabase.Query("SELECT id, spell_id FROM spell_group");
@@ -1860,6 +1874,7 @@ void SpellMgr::LoadSpellGroupStackRules()
     uint32 oldMSTime = getMSTime();
 
     mSpellGroupStack.clear();                                  // need for reload case
+    ++_spellGroupDataVersion;                                  // units drop their cached aura type totals
 
     //                                                       0         1
     QueryResult result = WorldDatabase.Query("SELECT group_id, stack_rule FROM spell_group_stack_rules");
@@ -1903,6 +1918,7 @@ void SpellMgr::LoadSpellProcEvents()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcEventMap.clear();                             // need for reload case
+    ++_procDataVersion;                                     // units rebuild their proc aura index
 
     //                                                0      1           2                3                 4                 5                 6                 7          8       9        10            11
     QueryResult result = WorldDatabase.Query("SELECT entry, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, SpellFamilyMask3, procFlags, procEx, ppmRate, CustomChance, Cooldown FROM spell_proc_event");
@@ -1991,6 +2007,7 @@ void SpellMgr::LoadSpellProcs()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcMap.clear();                             // need for reload case
+    ++_procDataVersion;                                // units rebuild their proc aura index
 
     //                                                 0        1           2                3                 4                 5                 6                7         8              9               10        11             12             13     14         15
     QueryResult result = WorldDatabase.Query("SELECT spellId, schoolMask, spellFamilyName, spellFamilyMask0, spellFamilyMask1, spellFamilyMask2, spellFamilyMask3, typeMask, spellTypeMask, spellPhaseMask, hitMask, attributesMask, ratePerMinute, chance, cooldown, charges FROM spell_proc");
@@ -643,9 +643,12 @@ class SpellMgr
         bool AddSameEffectStackRuleSpellGroups(SpellInfo const* spellInfo, int32 amount, std::map<SpellGroup, int32>& groups) const;
         SpellGroupStackRule CheckSpellGroupStackRules(SpellInfo const* spellInfo1, SpellInfo const* spellInfo2) const;
         SpellGroupStackRule GetSpellGroupStackRule(SpellGroup groupid) const;
+        uint32 GetSpellGroupDataVersion() const { return _spellGroupDataVersion; }
 
         // Spell proc event table
         SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const;
+        uint32 GetSpellProcEventFlags(SpellInfo const* spellInfo) const;
+        uint32 GetProcDataVersion() const { return _procDataVersion; }
         bool IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, SpellInfo const* procSpell, uint32 procFlags, uint32 procExtra, bool active) const;
 
         // Spell proc table
@@ -731,8 +734,10 @@ class SpellMgr
         SpellSpellGroupMap         mSpellSpellGroup;
         SpellGroupSpellMap         mSpellGroupSpell;
         SpellGroupStackMap         mSpellGroupStack;
+        uint32                     _spellGroupDataVersion;  // changed on every spell_group/spell_group_stack_rules (re)load
         SpellProcEventMap          mSpellProcEventMap;
         SpellProcMap               mSpellProcMap;
+        uint32                     _procDataVersion;        // changed on every spell_proc_event/spell_proc (re)load
         SpellThreatMap             mSpellThreatMap;
         SpellPetAuraMap            mSpellPetAuraMap;
         SpellLinkedMap             mSpellLinkedMap;
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterInfoCache.h"
+#include "Errors.h"
+#include "SharedDefines.h"
+#include <algorithm>
+
+CharacterInfoCacheStatistics CharacterInfoCache::_statistics;
+uint32 const CharacterInfoCache::EmptyBucket;
+
+CharacterInfoCache::CharacterInfoCache() : _capacity(0), _accessClock(0), _size(0)
+{
+    _buckets.resize(1024, EmptyBucket);
+}
+
+std::size_t CharacterInfoCache::GetBucket(ObjectGuid::LowType guid) const
+{
+    uint64 hash = guid * UI64LIT(0x9E3779B97F4A7C15);
+    return std::size_t(hash ^ (hash >> 32)) & (_buckets.size() - 1);
+}
+
+uint32 CharacterInfoCache::FindSlot(ObjectGuid::LowType guid) const
+{
+    std::size_t mask = _buckets.size() - 1;
+    for (std::size_t i = GetBucket(guid); _buckets[i] != EmptyBucket; i = (i + 1) & mask)
+        if (_entries[_buckets[i]].Guid == guid)
+            return _buckets[i];
+
+    return EmptyBucket;
+}
+
+CharacterInfoCache::Entry& CharacterInfoCache::Insert(ObjectGuid::LowType guid)
+{
+    uint32 slot = FindSlot(guid);
+    if (slot != EmptyBucket)
+    {
+        Entry& entry = _entries[slot];
+        if (entry.Exists)
+            ReleaseName(entry.Name);
+
+        return entry;
+    }
+
+    // keep the table at most half full so probe sequences stay short
+    if ((_size + 1) * 2 > _buckets.size())
+        Rehash(_buckets.size() * 2);
+
+    if (!_freeSlots.empty())
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else
+    {
+        slot = uint32(_entries.size());
+        _entries.emplace_back();
+    }
+
+    std::size_t mask = _buckets.size() - 1;
+    std::size_t i = GetBucket(guid);
+    while (_buckets[i] != EmptyBucket)
+        i = (i + 1) & mask;
+
+    _buckets[i] = slot;
+    ++_size;
+
+    Entry& entry = _entries[slot];
+    entry.Guid = guid;
+    return entry;
+}
+
+void CharacterInfoCache::EraseSlot(uint32 slot)
+{
+    Entry& entry = _entries[slot];
+    std::size_t mask = _buckets.size() - 1;
+    std::size_t i = GetBucket(entry.Guid);
+    while (_buckets[i] != slot)
+        i = (i + 1) & mask;
+
+    // backward shift deletion - pull following entries of the probe sequence into the hole
+    _buckets[i] = EmptyBucket;
+    for (std::size_t j = (i + 1) & mask; _buckets[j] != EmptyBucket; j = (j + 1) & mask)
+    {
+        std::size_t home = GetBucket(_entries[_buckets[j]].Guid);
+        bool reachable = i <= j ? (home <= i || home > j) : (home <= i && home > j);
+        if (reachable)
+        {
+            _buckets[i] = _buckets[j];
+            _buckets[j] = EmptyBucket;
+            i = j;
+        }
+    }
+
+    if (entry.Exists)
+        ReleaseName(entry.Name);
+
+    entry.Exists = false;
+    entry.Name = nullptr;
+    _freeSlots.push_back(slot);
+    --_size;
+}
+
+void CharacterInfoCache::Rehash(std::size_t bucketCount)
+{
+    std::vector<uint32> oldBuckets(bucketCount, EmptyBucket);
+    _buckets.swap(oldBuckets);
+
+    std::size_t mask = _buckets.size() - 1;
+    for (uint32 slot : oldBuckets)
+    {
+        if (slot == EmptyBucket)
+            continue;
+
+        std::size_t i = GetBucket(_entries[slot].Guid);
+        while (_buckets[i] != EmptyBucket)
+            i = (i + 1) & mask;
+
+        _buckets[i] = slot;
+    }
+}
+
+char const* CharacterInfoCache::InternName(std::string const& name)
+{
+    // node based container, the key does not move while it is referenced
+    auto itr = _names.insert(std::make_pair(name, 0u)).first;
+    ++itr->second;
+    return itr->first.c_str();
+}
+
+void CharacterInfoCache::ReleaseName(char const* name)
+{
+    auto itr = _names.find(name);
+    ASSERT(itr != _names.end());
+    if (!--itr->second)
+        _names.erase(itr);
+}
+
+bool CharacterInfoCache::Find(ObjectGuid::LowType guid, bool& exists, CharacterInfo* info /*= nullptr*/)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    uint32 slot = FindSlot(guid);
+    if (slot == EmptyBucket)
+    {
+        ++_statistics.Misses;
+        exists = false;
+        return false;
+    }
+
+    ++_statistics.Hits;
+    Entry& entry = _entries[slot];
+    entry.LastAccess = ++_accessClock;
+    exists = entry.Exists;
+    if (exists && info)
+    {
+        info->Name = entry.Name;
+        info->Class = entry.Class;
+        info->Race = entry.Race;
+        info->Sex = entry.Sex;
+        info->Level = entry.Level;
+        info->IsDeleted = entry.IsDeleted;
+    }
+
+    return true;
+}
+
+void CharacterInfoCache::Store(ObjectGuid::LowType guid, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level, bool isDeleted)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    Entry& entry = Insert(guid);
+    entry.LastAccess = ++_accessClock;
+    entry.Exists = true;
+    entry.Name = InternName(name);
+    entry.Race = race;
+    entry.Sex = gender;
+    entry.Class = playerClass;
+    entry.Level = level;
+    entry.IsDeleted = isDeleted;
+}
+
+void CharacterInfoCache::StoreMissing(ObjectGuid::LowType guid)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    Entry& entry = Insert(guid);
+    entry.LastAccess = ++_accessClock;
+    entry.Exists = false;
+    entry.Name = nullptr;
+}
+
+void CharacterInfoCache::Remove(ObjectGuid::LowType guid)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    uint32 slot = FindSlot(guid);
+    if (slot != EmptyBucket)
+        EraseSlot(slot);
+}
+
+void CharacterInfoCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::vector<uint32>(1024, EmptyBucket).swap(_buckets);
+    _entries.clear();
+    _freeSlots.clear();
+    _names.clear();
+    _size = 0;
+}
+
+bool CharacterInfoCache::UpdateName(ObjectGuid::LowType guid, std::string const& name, uint8 gender, uint8 race)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    uint32 slot = FindSlot(guid);
+    if (slot == EmptyBucket || !_entries[slot].Exists)
+        return false;
+
+    Entry& entry = _entries[slot];
+    char const* oldName = entry.Name;
+    entry.Name = InternName(name);
+    ReleaseName(oldName);
+
+    if (gender != GENDER_NONE)
+        entry.Sex = gender;
+
+    if (race != RACE_NONE)
+        entry.Race = race;
+
+    return true;
+}
+
+bool CharacterInfoCache::UpdateLevel(ObjectGuid::LowType guid, uint8 level)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    uint32 slot = FindSlot(guid);
+    if (slot == EmptyBucket || !_entries[slot].Exists)
+        return false;
+
+    _entries[slot].Level = level;
+    return true;
+}
+
+bool CharacterInfoCache::UpdateDeleted(ObjectGuid::LowType guid, bool deleted, std::string const* name)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    uint32 slot = FindSlot(guid);
+    if (slot == EmptyBucket || !_entries[slot].Exists)
+        return false;
+
+    Entry& entry = _entries[slot];
+    entry.IsDeleted = deleted;
+
+    if (name)
+    {
+        char const* oldName = entry.Name;
+        entry.Name = InternName(*name);
+        ReleaseName(oldName);
+    }
+
+    return true;
+}
+
+void CharacterInfoCache::Trim()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    // let the cache overshoot a little so the scan below does not run on every insert
+    if (!_capacity || _size <= _capacity + _capacity / 8)
+        return;
+
+    std::vector<std::pair<uint32, uint32>> ages;           // age, slot
+    ages.reserve(_size);
+    for (uint32 slot : _buckets)
+        if (slot != EmptyBucket)
+            ages.push_back(std::make_pair(_accessClock - _entries[slot].LastAccess, slot));
+
+    std::size_t evicted = _size - _capacity;
+    std::nth_element(ages.begin(), ages.begin() + evicted, ages.end(), [](std::pair<uint32, uint32> const& left, std::pair<uint32, uint32> const& right)
+    {
+        return left.first > right.first;
+    });
+
+    for (std::size_t i = 0; i < evicted; ++i)
+        EraseSlot(ages[i].second);
+
+    _statistics.Evictions += evicted;
+}
+
+std::size_t CharacterInfoCache::GetSize()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _size;
+}
+
+std::size_t CharacterInfoCache::GetMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::size_t memory = _buckets.capacity() * sizeof(uint32) + _entries.size() * sizeof(Entry) + _freeSlots.capacity() * sizeof(uint32);
+    for (auto const& name : _names)
+        memory += sizeof(name) + 2 * sizeof(void*) + (name.first.capacity() > 15 ? name.first.capacity() + 1 : 0);
+
+    return memory;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHARACTER_INFO_CACHE_H
+#define CHARACTER_INFO_CACHE_H
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct CharacterInfo
+{
+    std::string Name;
+    uint8 Class;
+    uint8 Race;
+    uint8 Sex;
+    uint8 Level;
+    bool IsDeleted;
+};
+
+struct CharacterInfoCacheStatistics
+{
+    std::atomic<uint64> Hits;
+    std::atomic<uint64> Misses;
+    std::atomic<uint64> SyncFills;
+    std::atomic<uint64> AsyncFills;
+    std::atomic<uint64> Evictions;
+};
+
+/// Bounded cache of CharacterInfo keyed by player low guid.
+/// Entries live in a slab indexed by an open addressing (linear probing) table, names are interned.
+/// Characters known not to exist are cached as well so repeated lookups do not hit the database.
+/// All methods are thread safe, lookups return a copy made under the lock.
+class CharacterInfoCache
+{
+    public:
+        CharacterInfoCache();
+
+        /// Maximum number of cached characters, 0 means unbounded
+        void SetCapacity(uint32 capacity) { _capacity = capacity; }
+        uint32 GetCapacity() const { return _capacity; }
+
+        /// Returns true if the cache holds an answer for guid, exists is false for characters known not to exist.
+        /// info (optional) is filled for existing characters.
+        bool Find(ObjectGuid::LowType guid, bool& exists, CharacterInfo* info = nullptr);
+
+        void Store(ObjectGuid::LowType guid, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level, bool isDeleted);
+        void StoreMissing(ObjectGuid::LowType guid);
+        void Remove(ObjectGuid::LowType guid);
+        void Clear();
+
+        bool UpdateName(ObjectGuid::LowType guid, std::string const& name, uint8 gender, uint8 race);
+        bool UpdateLevel(ObjectGuid::LowType guid, uint8 level);
+        bool UpdateDeleted(ObjectGuid::LowType guid, bool deleted, std::string const* name);
+
+        /// Evicts least recently used entries once the cache grew past its capacity
+        void Trim();
+
+        std::size_t GetSize();
+        std::size_t GetMemoryUsage();
+
+        static CharacterInfoCacheStatistics const& GetStatistics() { return _statistics; }
+        static void RecordFill(bool async) { ++(async ? _statistics.AsyncFills : _statistics.SyncFills); }
+
+    private:
+        struct Entry
+        {
+            ObjectGuid::LowType Guid;
+            uint32 LastAccess;
+            bool Exists;
+            char const* Name;                               // interned, shared by all characters with the same name
+            uint8 Class;
+            uint8 Race;
+            uint8 Sex;
+            uint8 Level;
+            bool IsDeleted;
+        };
+
+        static uint32 const EmptyBucket = 0xFFFFFFFF;
+
+        uint32 FindSlot(ObjectGuid::LowType guid) const;
+        Entry& Insert(ObjectGuid::LowType guid);
+        void EraseSlot(uint32 slot);
+        void Rehash(std::size_t bucketCount);
+        std::size_t GetBucket(ObjectGuid::LowType guid) const;
+
+        char const* InternName(std::string const& name);
+        void ReleaseName(char const* name);
+
+        std::mutex _lock;
+        uint32 _capacity;
+        uint32 _accessClock;
+
+        std::vector<uint32> _buckets;                       // slot in _entries or EmptyBucket
+        std::deque<Entry> _entries;                         // deque keeps entries in place while growing
+        std::vector<uint32> _freeSlots;
+        std::size_t _size;
+
+        std::unordered_map<std::string, uint32> _names;     // interned name -> reference count
+
+        static CharacterInfoCacheStatistics _statistics;
+};
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoaderTaskGraph.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+#include <thread>
+
+void LoaderTaskGraph::AddTask(std::string const& name, Loader const& loader, std::initializer_list<char const*> dependencies)
+{
+    ASSERT(FindTask(name) == _tasks.size(), "Loader %s added twice to %s", name.c_str(), _name.c_str());
+
+    Task task;
+    task.Name = name;
+    task.Function = loader;
+    task.PendingDependencies = 0;
+    task.StartTime = 0;
+    task.FinishTime = 0;
+
+    size_t index = _tasks.size();
+    for (char const* dependency : dependencies)
+    {
+        size_t dependencyIndex = FindTask(dependency);
+        ASSERT(dependencyIndex < _tasks.size(), "Loader %s depends on unknown loader %s", name.c_str(), dependency);
+        task.Dependencies.push_back(dependencyIndex);
+        _tasks[dependencyIndex].Dependents.push_back(index);
+    }
+
+    _tasks.push_back(task);
+}
+
+size_t LoaderTaskGraph::FindTask(std::string const& name) const
+{
+    for (size_t i = 0; i < _tasks.size(); ++i)
+        if (_tasks[i].Name == name)
+            return i;
+
+    return _tasks.size();
+}
+
+void LoaderTaskGraph::Run(uint32 threadCount)
+{
+    if (_tasks.empty())
+        return;
+
+    if (!threadCount)
+        threadCount = 1;
+    if (threadCount > _tasks.size())
+        threadCount = uint32(_tasks.size());
+
+    _readyTasks.clear();
+    _pendingTasks = _tasks.size();
+    _exception = nullptr;
+    for (size_t i = 0; i < _tasks.size(); ++i)
+    {
+        _tasks[i].PendingDependencies = uint32(_tasks[i].Dependencies.size());
+        if (!_tasks[i].PendingDependencies)
+            _readyTasks.push_back(i);
+    }
+
+    uint32 startTime = getMSTime();
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < threadCount; ++i)
+        workers.push_back(std::thread(&LoaderTaskGraph::WorkerThread, this, startTime));
+
+    WorkerThread(startTime);
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    if (_exception)
+        std::rethrow_exception(_exception);
+
+    LogReport(GetMSTimeDiffToNow(startTime), threadCount);
+}
+
+void LoaderTaskGraph::WorkerThread(uint32 startTime)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    for (;;)
+    {
+        _condition.wait(lock, [this] { return !_readyTasks.empty() || !_pendingTasks || _exception; });
+        if (_readyTasks.empty() || _exception)
+            break;
+
+        size_t index = _readyTasks.front();
+        _readyTasks.pop_front();
+        Task& task = _tasks[index];
+
+        lock.unlock();
+        task.StartTime = GetMSTimeDiffToNow(startTime);
+        std::exception_ptr exception;
+        try
+        {
+            task.Function();
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+        task.FinishTime = GetMSTimeDiffToNow(startTime);
+        lock.lock();
+
+        if (exception)
+        {
+            TC_LOG_ERROR("server.loading", ">> %s: loader %s failed, aborting", _name.c_str(), task.Name.c_str());
+            if (!_exception)
+                _exception = exception;
+
+            _condition.notify_all();
+            break;
+        }
+
+        --_pendingTasks;
+        for (size_t dependent : task.Dependents)
+            if (!--_tasks[dependent].PendingDependencies)
+                _readyTasks.push_back(dependent);
+
+        _condition.notify_all();
+    }
+}
+
+void LoaderTaskGraph::LogReport(uint32 wallTime, uint32 threadCount) const
+{
+    uint32 loaderTime = 0;
+    size_t last = 0;
+    for (size_t i = 0; i < _tasks.size(); ++i)
+    {
+        Task const& task = _tasks[i];
+        loaderTime += task.FinishTime - task.StartTime;
+        if (task.FinishTime > _tasks[last].FinishTime)
+            last = i;
+
+        TC_LOG_INFO("server.loading", ">> %s: %s took %u ms (started at %u ms)", _name.c_str(), task.Name.c_str(), task.FinishTime - task.StartTime, task.StartTime);
+    }
+
+    // Walk back from the loader that finished last, always through the dependency that kept it waiting longest
+    std::string criticalPath = _tasks[last].Name;
+    for (size_t current = last; !_tasks[current].Dependencies.empty();)
+    {
+        size_t blocking = _tasks[current].Dependencies.front();
+        for (size_t dependency : _tasks[current].Dependencies)
+            if (_tasks[dependency].FinishTime > _tasks[blocking].FinishTime)
+                blocking = dependency;
+
+        criticalPath = _tasks[blocking].Name + " -> " + criticalPath;
+        current = blocking;
+    }
+
+    TC_LOG_INFO("server.loading", ">> %s: %u loaders finished in %u ms on %u threads (%u ms spent in loaders)",
+        _name.c_str(), uint32(_tasks.size()), wallTime, threadCount, loaderTime);
+    TC_LOG_INFO("server.loading", ">> %s: critical path %s", _name.c_str(), criticalPath.c_str());
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LOADER_TASK_GRAPH_H
+#define _LOADER_TASK_GRAPH_H
+
+#include "Define.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Runs a group of startup loaders on a small thread pool, starting each loader
+/// only once every loader it depends on has finished.
+/// Dependencies may only name loaders added earlier, so the graph is always acyclic
+/// and running it on a single thread reproduces the order the loaders were added in.
+class LoaderTaskGraph
+{
+    public:
+        typedef std::function<void()> Loader;
+
+        explicit LoaderTaskGraph(std::string const& name) : _name(name), _pendingTasks(0) { }
+
+        void AddTask(std::string const& name, Loader const& loader, std::initializer_list<char const*> dependencies = {});
+
+        /// Runs all added loaders using up to threadCount threads (the calling thread included)
+        /// and logs per loader timings together with the critical path of the graph.
+        /// If a loader throws, no further loaders are started and the exception is rethrown
+        /// on the calling thread once the loaders already running have finished.
+        void Run(uint32 threadCount);
+
+    private:
+        struct Task
+        {
+            std::string Name;
+            Loader Function;
+            std::vector<size_t> Dependencies;
+            std::vector<size_t> Dependents;
+            uint32 PendingDependencies;
+            uint32 StartTime;
+            uint32 FinishTime;
+        };
+
+        size_t FindTask(std::string const& name) const;
+        void WorkerThread(uint32 startTime);
+        void LogReport(uint32 wallTime, uint32 threadCount) const;
+
+        std::string _name;
+        std::vector<Task> _tasks;
+
+        std::mutex _lock;
+        std::condition_variable _condition;
+        std::deque<size_t> _readyTasks;
+        size_t _pendingTasks;
+        std::exception_ptr _exception;                      // first exception thrown by a loader
+};
+
+#endif
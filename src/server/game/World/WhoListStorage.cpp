@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WhoListStorage.h"
+#include "GuildMgr.h"
+#include "Player.h"
+#include "Util.h"
+
+static std::wstring GetLowerWideName(std::string const& name)
+{
+    std::wstring wname;
+    if (!Utf8toWStr(name, wname))
+        return std::wstring();
+
+    wstrToLower(wname);
+    return wname;
+}
+
+void WhoListStorage::AddToBucket(std::vector<WhoListPlayerInfo*>& bucket, WhoListPlayerInfo* info, uint32 WhoListPlayerInfo::* slot)
+{
+    info->*slot = uint32(bucket.size());
+    bucket.push_back(info);
+}
+
+void WhoListStorage::RemoveFromBucket(std::vector<WhoListPlayerInfo*>& bucket, WhoListPlayerInfo* info, uint32 WhoListPlayerInfo::* slot)
+{
+    WhoListPlayerInfo* last = bucket.back();
+    bucket[info->*slot] = last;
+    last->*slot = info->*slot;
+    bucket.pop_back();
+}
+
+void WhoListStorage::RemoveFromZone(WhoListPlayerInfo* info)
+{
+    auto itr = _playersByZone.find(info->ZoneId);
+    RemoveFromBucket(itr->second, info, &WhoListPlayerInfo::ZoneSlot);
+    if (itr->second.empty())
+        _playersByZone.erase(itr);
+}
+
+void WhoListStorage::AddPlayer(Player* player)
+{
+    // string conversions and guild lookup outside of the lock
+    std::wstring name = GetLowerWideName(player->GetName());
+    std::wstring guildName = GetLowerWideName(sGuildMgr->GetGuildNameById(player->GetGuildId()));
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _players.find(player->GetGUID());
+    if (itr != _players.end())
+    {
+        RemoveFromBucket(_playersByLevel[itr->second.Level], &itr->second, &WhoListPlayerInfo::LevelSlot);
+        RemoveFromZone(&itr->second);
+    }
+    else
+        itr = _players.insert(std::make_pair(player->GetGUID(), WhoListPlayerInfo())).first;
+
+    WhoListPlayerInfo& info = itr->second;
+    info.Target = player;
+    info.Guid = player->GetGUID();
+    info.Team = player->GetTeam();
+    info.ZoneId = player->GetZoneId();
+    info.GuildId = player->GetGuildId();
+    info.Level = player->getLevel();
+    info.Class = player->getClass();
+    info.Race = player->getRace();
+    info.Name.swap(name);
+    info.GuildName.swap(guildName);
+
+    AddToBucket(_playersByLevel[info.Level], &info, &WhoListPlayerInfo::LevelSlot);
+    AddToBucket(_playersByZone[info.ZoneId], &info, &WhoListPlayerInfo::ZoneSlot);
+}
+
+void WhoListStorage::RemovePlayer(ObjectGuid const& guid)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _players.find(guid);
+    if (itr == _players.end())
+        return;
+
+    RemoveFromBucket(_playersByLevel[itr->second.Level], &itr->second, &WhoListPlayerInfo::LevelSlot);
+    RemoveFromZone(&itr->second);
+    _players.erase(itr);
+}
+
+void WhoListStorage::UpdateLevel(ObjectGuid const& guid, uint8 level)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _players.find(guid);
+    if (itr == _players.end() || itr->second.Level == level)
+        return;
+
+    RemoveFromBucket(_playersByLevel[itr->second.Level], &itr->second, &WhoListPlayerInfo::LevelSlot);
+    itr->second.Level = level;
+    AddToBucket(_playersByLevel[level], &itr->second, &WhoListPlayerInfo::LevelSlot);
+}
+
+void WhoListStorage::UpdateZone(ObjectGuid const& guid, uint32 zoneId)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _players.find(guid);
+    if (itr == _players.end() || itr->second.ZoneId == zoneId)
+        return;
+
+    RemoveFromZone(&itr->second);
+    itr->second.ZoneId = zoneId;
+    AddToBucket(_playersByZone[zoneId], &itr->second, &WhoListPlayerInfo::ZoneSlot);
+}
+
+void WhoListStorage::UpdateGuild(ObjectGuid const& guid, ObjectGuid::LowType guildId)
+{
+    std::wstring guildName = GetLowerWideName(sGuildMgr->GetGuildNameById(guildId));
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _players.find(guid);
+    if (itr == _players.end())
+        return;
+
+    itr->second.GuildId = guildId;
+    itr->second.GuildName.swap(guildName);
+}
+
+void WhoListStorage::UpdateGuildName(ObjectGuid::LowType guildId, std::string const& name)
+{
+    std::wstring guildName = GetLowerWideName(name);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    for (auto& player : _players)
+        if (player.second.GuildId == guildId)
+            player.second.GuildName = guildName;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WHO_LIST_STORAGE_H
+#define WHO_LIST_STORAGE_H
+
+#include "Define.h"
+#include "DBCEnums.h"
+#include "ObjectGuid.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Player;
+
+struct WhoListPlayerInfo
+{
+    Player* Target;                                         // valid while the entry exists, entries are removed before the player leaves the world
+    ObjectGuid Guid;
+    uint32 Team;
+    uint32 ZoneId;
+    ObjectGuid::LowType GuildId;
+    uint8 Level;
+    uint8 Class;
+    uint8 Race;
+    std::wstring Name;                                      // lower case, for /who filters
+    std::wstring GuildName;                                 // lower case, for /who filters
+
+    uint32 LevelSlot;                                       // position in WhoListStorage::_playersByLevel[Level]
+    uint32 ZoneSlot;                                        // position in WhoListStorage::_playersByZone[ZoneId]
+};
+
+/// Players in world indexed for /who requests by level and zone, with names already
+/// lower cased so a request does not convert every online name again.
+/// Kept up to date from Player::AddToWorld/RemoveFromWorld, level, zone and guild changes.
+/// /who only takes the storage lock instead of the global player map lock.
+class WhoListStorage
+{
+    public:
+        static WhoListStorage* instance()
+        {
+            static WhoListStorage instance;
+            return &instance;
+        }
+
+        void AddPlayer(Player* player);
+        void RemovePlayer(ObjectGuid const& guid);
+        void UpdateLevel(ObjectGuid const& guid, uint8 level);
+        void UpdateZone(ObjectGuid const& guid, uint32 zoneId);
+        void UpdateGuild(ObjectGuid const& guid, ObjectGuid::LowType guildId);
+        void UpdateGuildName(ObjectGuid::LowType guildId, std::string const& name);
+
+        /// Calls visitor with every player in the level range that passes the race, class (-1 = any) and zone (empty = any) filters,
+        /// until it returns false. Entries and their Target stay valid during the call.
+        template<class Visitor>
+        void Visit(uint32 minLevel, uint32 maxLevel, int32 raceMask, int32 classMask, std::vector<int32> const& zones, Visitor visitor) const
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            if (maxLevel > STRONG_MAX_LEVEL)
+                maxLevel = STRONG_MAX_LEVEL;
+
+            auto matches = [=](WhoListPlayerInfo const* info)
+            {
+                return info->Level >= minLevel && info->Level <= maxLevel &&
+                    (classMask < 0 || (classMask & (1 << info->Class))) &&
+                    (raceMask < 0 || (raceMask & (1 << info->Race)));
+            };
+
+            if (!zones.empty())
+            {
+                for (int32 zoneId : zones)
+                {
+                    auto itr = _playersByZone.find(uint32(zoneId));
+                    if (itr == _playersByZone.end())
+                        continue;
+
+                    for (WhoListPlayerInfo const* info : itr->second)
+                        if (matches(info) && !visitor(*info))
+                            return;
+                }
+                return;
+            }
+
+            for (uint32 level = minLevel; level <= maxLevel; ++level)
+                for (WhoListPlayerInfo const* info : _playersByLevel[level])
+                    if (matches(info) && !visitor(*info))
+                        return;
+        }
+
+    private:
+        WhoListStorage() { }
+        ~WhoListStorage() { }
+
+        static void AddToBucket(std::vector<WhoListPlayerInfo*>& bucket, WhoListPlayerInfo* info, uint32 WhoListPlayerInfo::* slot);
+        static void RemoveFromBucket(std::vector<WhoListPlayerInfo*>& bucket, WhoListPlayerInfo* info, uint32 WhoListPlayerInfo::* slot);
+        void RemoveFromZone(WhoListPlayerInfo* info);
+
+        mutable std::mutex _lock;
+        std::unordered_map<ObjectGuid, WhoListPlayerInfo> _players;     // node based, indexes below point into it
+        std::vector<WhoListPlayerInfo*> _playersByLevel[STRONG_MAX_LEVEL + 1];
+        std::unordered_map<uint32, std::vector<WhoListPlayerInfo*>> _playersByZone;
+};
+
+#define sWhoListStorage WhoListStorage::instance()
+
+#endif
@@ -44,6 +44,7 @@
 #include "GuildFinderMgr.h"
 #include "InstanceSaveMgr.h"
 #include "Language.h"
+#include "LoaderTaskGraph.h"
 #include "LFGMgr.h"
 #include "MapManager.h"
 #include "Memory.h"
@@ -1067,6 +1068,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_CHATFLOOD_MUTE_TIME]     = sConfigMgr->GetIntDefault("ChatFlood.MuteTime", 10);
 
     m_bool_configs[CONFIG_EVENT_ANNOUNCE] = sConfigMgr->GetBoolDefault("Event.Announce", false);
+    m_int_configs[CONFIG_EVENT_STAGED_SPAWN_TIME] = sConfigMgr->GetIntDefault("Event.StagedSpawnTime", 0);
 
     m_float_configs[CONFIG_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS] = sConfigMgr->GetFloatDefault("CreatureFamilyFleeAssistanceRadius", 30.0f);
     m_float_configs[CONFIG_CREATURE_FAMILY_ASSISTANCE_RADIUS] = sConfigMgr->GetFloatDefault("CreatureFamilyAssistanceRadius", 10.0f);
@@ -1313,6 +1315,10 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = sConfigMgr->GetIntDefault("Startup.LoaderThreads", 4);
+    if (m_int_configs[CONFIG_STARTUP_LOADER_THREADS] < 1)
+        m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = 1;
+    m_int_configs[CONFIG_CHARACTER_INFO_CACHE_SIZE] = sConfigMgr->GetIntDefault("CharacterInfoCache.MaxEntries", 100000);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1515,69 +1521,125 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading instances...");
     sInstanceSaveMgr->LoadInstances();
 
-    TC_LOG_INFO("server.loading", "Loading Localization strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadQuestTemplateLocale();
-    sObjectMgr->LoadQuestObjectivesLocale();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
+    // The loaders below only touch their own stores and only read DBC/DB2 data and SpellInfo lookups,
+    // so independent groups of them can run at the same time
+    LoaderTaskGraph templateLoaders("Template loaders");
 
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    TC_LOG_INFO("server.loading", ">> Localization strings loaded in %u ms", GetMSTimeDiffToNow(oldMSTime));
+    templateLoaders.AddTask("creature_template_locale", [] { sObjectMgr->LoadCreatureLocales(); });
+    templateLoaders.AddTask("gameobject_template_locale", [] { sObjectMgr->LoadGameObjectLocales(); });
+    templateLoaders.AddTask("quest_template_locale", [] { sObjectMgr->LoadQuestTemplateLocale(); });
+    templateLoaders.AddTask("quest_objectives_locale", [] { sObjectMgr->LoadQuestObjectivesLocale(); });
+    templateLoaders.AddTask("page_text_locale", [] { sObjectMgr->LoadPageTextLocales(); });
+    templateLoaders.AddTask("gossip_menu_option_locale", [] { sObjectMgr->LoadGossipMenuItemsLocales(); });
+    templateLoaders.AddTask("points_of_interest_locale", [] { sObjectMgr->LoadPointOfInterestLocales(); });
 
-    TC_LOG_INFO("server.loading", "Loading Account Roles and Permissions...");
-    sAccountMgr->LoadRBAC();
+    templateLoaders.AddTask("rbac", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Account Roles and Permissions...");
+        sAccountMgr->LoadRBAC();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
+    templateLoaders.AddTask("page_text", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Page Texts...");
+        sObjectMgr->LoadPageTexts();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
+    templateLoaders.AddTask("gameobject_template", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Game Object Templates...");
+        sObjectMgr->LoadGameObjectTemplate();
+    }, { "page_text" });
 
-    TC_LOG_INFO("server.loading", "Loading Transport templates...");
-    sTransportMgr->LoadTransportTemplates();
+    templateLoaders.AddTask("transport_template", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Transport templates...");
+        sTransportMgr->LoadTransportTemplates();
+    }, { "gameobject_template" });
 
-    TC_LOG_INFO("server.loading", "Loading Spell Rank Data...");
-    sSpellMgr->LoadSpellRanks();
+    // SpellMgr loaders fill SpellInfo fields and cross reference each other, keep them in their original order
+    templateLoaders.AddTask("spell_ranks", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Spell Rank Data...");
+        sSpellMgr->LoadSpellRanks();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
+    templateLoaders.AddTask("spell_required", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Spell Required Data...");
+        sSpellMgr->LoadSpellRequired();
+    }, { "spell_ranks" });
 
-    TC_LOG_INFO("server.loading", "Loading Spell Group types...");
-    sSpellMgr->LoadSpellGroups();
+    templateLoaders.AddTask("spell_group", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Spell Group types...");
+        sSpellMgr->LoadSpellGroups();
+    }, { "spell_required" });
 
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
+    templateLoaders.AddTask("spell_learn_skill", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Spell Learn Skills...");
+        sSpellMgr->LoadSpellLearnSkills();
+    }, { "spell_group" });
 
-    TC_LOG_INFO("server.loading", "Loading Spell Learn Spells...");
-    sSpellMgr->LoadSpellLearnSpells();
+    templateLoaders.AddTask("spell_learn_spell", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Spell Learn Spells...");
+        sSpellMgr->LoadSpellLearnSpells();
+    }, { "spell_learn_skill" });
 
-    TC_LOG_INFO("server.loading", "Loading Spell Proc Event conditions...");
-    sSpellMgr->LoadSpellProcEvents();
+    templateLoaders.AddTask("spell_proc_event", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Spell Proc Event conditions...");
+        sSpellMgr->LoadSpellProcEvents();
+    }, { "spell_learn_spell" });
 
-    TC_LOG_INFO("server.loading", "Loading Spell Proc conditions and data...");
-    sSpellMgr->LoadSpellProcs();
+    templateLoaders.AddTask("spell_proc", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Spell Proc conditions and data...");
+        sSpellMgr->LoadSpellProcs();
+    }, { "spell_proc_event" });
 
-    TC_LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
+    templateLoaders.AddTask("spell_threat", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
+        sSpellMgr->LoadSpellThreats();
+    }, { "spell_proc" });
 
-    TC_LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+    templateLoaders.AddTask("spell_group_stack_rules", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
+        sSpellMgr->LoadSpellGroupStackRules();
+    }, { "spell_threat" });
 
-    TC_LOG_INFO("server.loading", "Loading NPC Texts...");
-    sObjectMgr->LoadNPCText();
+    templateLoaders.AddTask("spell_enchant_proc_data", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Enchant Spells Proc datas...");
+        sSpellMgr->LoadSpellEnchantProcData();
+    }, { "spell_group_stack_rules" });
 
-    TC_LOG_INFO("server.loading", "Loading Enchant Spells Proc datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    templateLoaders.AddTask("npc_text", []
+    {
+        TC_LOG_INFO("server.loading", "Loading NPC Texts...");
+        sObjectMgr->LoadNPCText();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    templateLoaders.AddTask("item_enchantment_template", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
+        LoadRandomEnchantmentsTable();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Disables");                         // must be before loading quests and items
-    DisableMgr::LoadDisables();
+    templateLoaders.AddTask("disables", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Disables");
+        DisableMgr::LoadDisables();
+    });
+
+    TC_LOG_INFO("server.loading", "Loading Localization strings, page texts, gameobject templates and spell data...");
+    templateLoaders.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
+
+    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
 
     TC_LOG_INFO("server.loading", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
     sObjectMgr->LoadItemTemplates();
@@ -1752,74 +1814,158 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
     sObjectMgr->LoadFishingBaseSkillLevel();
 
-    TC_LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Modifier trees...");
-    sAchievementMgr->LoadAchievementCriteriaModifiersTree();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    TC_LOG_INFO("server.loading", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    TC_LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    TC_LOG_INFO("server.loading", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    // Achievement data and the dynamic character tables only depend on the templates loaded above;
+    // guilds are the only ones reading achievement data while loading
+    LoaderTaskGraph dynamicLoaders("Dynamic data loaders");
+
+    dynamicLoaders.AddTask("achievement_reference_list", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Achievements...");
+        sAchievementMgr->LoadAchievementReferenceList();
+    });
+
+    dynamicLoaders.AddTask("achievement_criteria_modifier_tree", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Achievement Criteria Modifier trees...");
+        sAchievementMgr->LoadAchievementCriteriaModifiersTree();
+    }, { "achievement_reference_list" });
+
+    dynamicLoaders.AddTask("achievement_criteria_list", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
+        sAchievementMgr->LoadAchievementCriteriaList();
+    }, { "achievement_criteria_modifier_tree" });
+
+    dynamicLoaders.AddTask("achievement_criteria_data", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
+    }, { "achievement_criteria_list" });
+
+    dynamicLoaders.AddTask("achievement_reward", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
+    }, { "achievement_criteria_data" });
+
+    dynamicLoaders.AddTask("achievement_reward_locale", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
+        sAchievementMgr->LoadRewardLocales();
+    }, { "achievement_reward" });
+
+    dynamicLoaders.AddTask("completed_achievements", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    });
 
     ///- Load dynamic data tables from the database
-    TC_LOG_INFO("server.loading", "Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
+    dynamicLoaders.AddTask("auctionhouse_items", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Item Auctions...");
+        sAuctionMgr->LoadAuctionItems();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
+    dynamicLoaders.AddTask("auctionhouse", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Auctions...");
+        sAuctionMgr->LoadAuctions();
+    }, { "auctionhouse_items" });
 
-    TC_LOG_INFO("server.loading", "Loading Guild rewards...");
-    sGuildMgr->LoadGuildRewards();
+    dynamicLoaders.AddTask("guild_rewards", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Guild rewards...");
+        sGuildMgr->LoadGuildRewards();
+    }, { "achievement_reward_locale", "completed_achievements" });
 
-    TC_LOG_INFO("server.loading", "Loading Guilds...");
-    sGuildMgr->LoadGuilds();
+    dynamicLoaders.AddTask("guild", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Guilds...");
+        sGuildMgr->LoadGuilds();
+    }, { "guild_rewards" });
 
-    sGuildFinderMgr->LoadFromDB();
+    dynamicLoaders.AddTask("guild_finder", [] { sGuildFinderMgr->LoadFromDB(); }, { "guild" });
 
-    TC_LOG_INFO("server.loading", "Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
+    dynamicLoaders.AddTask("arena_team", []
+    {
+        TC_LOG_INFO("server.loading", "Loading ArenaTeams...");
+        sArenaTeamMgr->LoadArenaTeams();
+    });
+
+    dynamicLoaders.AddTask("groups", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Groups...");
+        sGroupMgr->LoadGroups();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Groups...");
-    sGroupMgr->LoadGroups();
+    dynamicLoaders.AddTask("reserved_name", []
+    {
+        TC_LOG_INFO("server.loading", "Loading ReservedNames...");
+        sObjectMgr->LoadReservedPlayersNames();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading ReservedNames...");
-    sObjectMgr->LoadReservedPlayersNames();
+    dynamicLoaders.AddTask("gameobject_for_quests", []
+    {
+        TC_LOG_INFO("server.loading", "Loading GameObjects for quests...");
+        sObjectMgr->LoadGameObjectForQuests();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading GameObjects for quests...");
-    sObjectMgr->LoadGameObjectForQuests();
+    dynamicLoaders.AddTask("battlemaster_entry", []
+    {
+        TC_LOG_INFO("server.loading", "Loading BattleMasters...");
+        sBattlegroundMgr->LoadBattleMastersEntry();             // must be after load CreatureTemplate
+    });
 
-    TC_LOG_INFO("server.loading", "Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();                 // must be after load CreatureTemplate
+    dynamicLoaders.AddTask("game_tele", []
+    {
+        TC_LOG_INFO("server.loading", "Loading GameTeleports...");
+        sObjectMgr->LoadGameTele();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
+    dynamicLoaders.AddTask("gossip_menu", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Gossip menu...");
+        sObjectMgr->LoadGossipMenu();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
+    dynamicLoaders.AddTask("gossip_menu_option", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Gossip menu options...");
+        sObjectMgr->LoadGossipMenuItems();
+    }, { "gossip_menu" });
 
-    TC_LOG_INFO("server.loading", "Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();
+    dynamicLoaders.AddTask("npc_vendor", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Vendors...");
+        sObjectMgr->LoadVendors();                               // must be after load CreatureTemplate and ItemTemplate
+    }, { "battlemaster_entry" });                                // battlemasters rewrite CreatureTemplate::npcflag
 
-    TC_LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    dynamicLoaders.AddTask("npc_trainer", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Trainers...");
+        sObjectMgr->LoadTrainerSpell();                          // must be after load CreatureTemplate
+    }, { "battlemaster_entry" });
 
-    TC_LOG_INFO("server.loading", "Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    dynamicLoaders.AddTask("waypoint_data", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Waypoints...");
+        sWaypointMgr->Load();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
+    dynamicLoaders.AddTask("waypoints", []
+    {
+        TC_LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
+        sSmartWaypointMgr->LoadFromDB();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+    dynamicLoaders.AddTask("creature_formations", []
+    {
+        TC_LOG_INFO("server.loading", "Loading Creature Formations...");
+        sFormationMgr->LoadCreatureFormations();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+    dynamicLoaders.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
 
     TC_LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
     LoadWorldStates();
@@ -1839,38 +1985,72 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Conditions...");
     sConditionMgr->LoadConditions();
 
-    TC_LOG_INFO("server.loading", "Loading faction change achievement pairs...");
-    sObjectMgr->LoadFactionChangeAchievements();
+    LoaderTaskGraph lookupLoaders("Faction change and ticket loaders");
 
-    TC_LOG_INFO("server.loading", "Loading faction change spell pairs...");
-    sObjectMgr->LoadFactionChangeSpells();
+    lookupLoaders.AddTask("player_factionchange_achievement", []
+    {
+        TC_LOG_INFO("server.loading", "Loading faction change achievement pairs...");
+        sObjectMgr->LoadFactionChangeAchievements();
+    });
+
+    lookupLoaders.AddTask("player_factionchange_spells", []
+    {
+        TC_LOG_INFO("server.loading", "Loading faction change spell pairs...");
+        sObjectMgr->LoadFactionChangeSpells();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading faction change item pairs...");
-    sObjectMgr->LoadFactionChangeItems();
+    lookupLoaders.AddTask("player_factionchange_items", []
+    {
+        TC_LOG_INFO("server.loading", "Loading faction change item pairs...");
+        sObjectMgr->LoadFactionChangeItems();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading faction change reputation pairs...");
-    sObjectMgr->LoadFactionChangeReputations();
+    lookupLoaders.AddTask("player_factionchange_reputations", []
+    {
+        TC_LOG_INFO("server.loading", "Loading faction change reputation pairs...");
+        sObjectMgr->LoadFactionChangeReputations();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading faction change title pairs...");
-    sObjectMgr->LoadFactionChangeTitles();
+    lookupLoaders.AddTask("player_factionchange_titles", []
+    {
+        TC_LOG_INFO("server.loading", "Loading faction change title pairs...");
+        sObjectMgr->LoadFactionChangeTitles();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading GM tickets...");
-    sSupportMgr->LoadGmTickets();
+    lookupLoaders.AddTask("gm_ticket", []
+    {
+        TC_LOG_INFO("server.loading", "Loading GM tickets...");
+        sSupportMgr->LoadGmTickets();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading GM bugs...");
-    sSupportMgr->LoadBugTickets();
+    lookupLoaders.AddTask("gm_bug", []
+    {
+        TC_LOG_INFO("server.loading", "Loading GM bugs...");
+        sSupportMgr->LoadBugTickets();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading GM complaints...");
-    sSupportMgr->LoadComplaintTickets();
+    lookupLoaders.AddTask("gm_complaint", []
+    {
+        TC_LOG_INFO("server.loading", "Loading GM complaints...");
+        sSupportMgr->LoadComplaintTickets();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading GM suggestions...");
-    sSupportMgr->LoadSuggestionTickets();
+    lookupLoaders.AddTask("gm_suggestion", []
+    {
+        TC_LOG_INFO("server.loading", "Loading GM suggestions...");
+        sSupportMgr->LoadSuggestionTickets();
+    });
 
     /*TC_LOG_INFO("server.loading", "Loading GM surveys...");
     sSupportMgr->LoadSurveys();*/
 
-    TC_LOG_INFO("server.loading", "Loading client addons...");
-    AddonMgr::LoadFromDB();
+    lookupLoaders.AddTask("addons", []
+    {
+        TC_LOG_INFO("server.loading", "Loading client addons...");
+        AddonMgr::LoadFromDB();
+    });
+
+    lookupLoaders.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
 
     TC_LOG_INFO("server.loading", "Loading garrison info...");
     sGarrisonMgr.Initialize();
@@ -2255,6 +2435,9 @@ void World::Update(uint32 diff)
     sGroupMgr->Update(diff);
     RecordTimeDiff("GroupMgr");
 
+    sGuildMgr->SendPendingCriteriaUpdates();
+    RecordTimeDiff("GuildMgr");
+
     // execute callbacks from sql queries that were queued recently
     ProcessQueryCallbacks();
     RecordTimeDiff("ProcessQueryCallbacks");
@@ -3318,45 +3501,134 @@ void World::ProcessQueryCallbacks()
         _UpdateRealmCharCount(result);
         itr = m_realmCharCallbacks.erase(itr);
     }
+
+    std::vector<std::pair<ObjectGuid::LowType, CharacterInfoQuery>> readyQueries;
+    {
+        std::lock_guard<std::mutex> lock(_characterInfoQueriesLock);
+        for (auto itr = _characterInfoQueries.begin(); itr != _characterInfoQueries.end();)
+        {
+            if (itr->second.Result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                ++itr;
+                continue;
+            }
+
+            readyQueries.push_back(std::make_pair(itr->first, std::move(itr->second)));
+            itr = _characterInfoQueries.erase(itr);
+        }
+    }
+
+    for (auto& query : readyQueries)
+    {
+        StoreCharacterInfo(query.first, query.second.Result.get());
+        CharacterInfoCache::RecordFill(true);
+
+        ObjectGuid guid = ObjectGuid::Create<HighGuid::Player>(query.first);
+        for (uint32 accountId : query.second.Requesters)
+            if (WorldSession* session = FindSession(accountId))
+                session->SendNameQueryOpcode(guid);
+    }
+
+    _characterInfoCache.Trim();
 }
 
 /**
- * @brief Loads several pieces of information on server startup with the GUID
- * There is no further database query necessary.
- * These are a number of methods that work into the calling function.
+ * @brief Looks up name, sex, race, class and level of a character by GUID
+ * Most recently played characters are loaded on server startup, others are
+ * loaded from the database the first time they are requested and kept in a
+ * bounded cache (see CharacterInfoCache.MaxEntries).
+ * Blocks on the database for characters that are not cached, callers that
+ * must not block (name queries) use GetCharacterInfoAsync instead.
  *
  * @param guid Requires a guid to call
- * @return Name, Sex, Race, Class and Level of player character
+ * @param info Receives a copy of Name, Sex, Race, Class and Level of player character
+ * @return true if the character is cached and exists
  * Example Usage:
  * @code
- *    CharacterInfo const* characterInfo = sWorld->GetCharacterInfo(GUID);
- *    if (!nameData)
+ *    CharacterInfo characterInfo;
+ *    if (!sWorld->GetCharacterInfo(GUID, characterInfo))
  *        return;
  *
- *    std::string playerName = characterInfo->Name;
- *    uint8 playerGender = characterInfo->Sex;
- *    uint8 playerRace = characterInfo->Race;
- *    uint8 playerClass = characterInfo->Class;
- *    uint8 playerLevel = characterInfo->Level;
+ *    std::string playerName = characterInfo.Name;
+ *    uint8 playerGender = characterInfo.Sex;
+ *    uint8 playerRace = characterInfo.Race;
+ *    uint8 playerClass = characterInfo.Class;
+ *    uint8 playerLevel = characterInfo.Level;
  * @endcode
  */
 
-CharacterInfo const* World::GetCharacterInfo(ObjectGuid const& guid) const
+bool World::GetCharacterInfo(ObjectGuid const& guid, CharacterInfo& info) const
 {
-    CharacterInfoContainer::const_iterator itr = _characterInfoStore.find(guid);
-    if (itr != _characterInfoStore.end())
-        return &itr->second;
+    if (!guid.IsPlayer())
+        return false;
 
-    return nullptr;
+    bool exists;
+    if (_characterInfoCache.Find(guid.GetCounter(), exists, &info))
+        return exists;
+
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_INFO);
+    stmt->setUInt64(0, guid.GetCounter());
+    StoreCharacterInfo(guid.GetCounter(), CharacterDatabase.Query(stmt));
+    CharacterInfoCache::RecordFill(false);
+
+    return _characterInfoCache.Find(guid.GetCounter(), exists, &info) && exists;
+}
+
+bool World::GetCharacterInfoAsync(ObjectGuid const& guid, uint32 accountId) const
+{
+    if (!guid.IsPlayer())
+        return true;
+
+    bool exists;
+    if (_characterInfoCache.Find(guid.GetCounter(), exists))
+        return true;
+
+    QueueCharacterInfoQuery(guid.GetCounter(), accountId);
+    return false;
+}
+
+void World::QueueCharacterInfoQuery(ObjectGuid::LowType guid, uint32 accountId) const
+{
+    std::lock_guard<std::mutex> lock(_characterInfoQueriesLock);
+
+    auto itr = _characterInfoQueries.find(guid);
+    if (itr == _characterInfoQueries.end())
+    {
+        PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_INFO);
+        stmt->setUInt64(0, guid);
+
+        itr = _characterInfoQueries.insert(std::make_pair(guid, CharacterInfoQuery())).first;
+        itr->second.Result = CharacterDatabase.AsyncQuery(stmt);
+    }
+
+    if (accountId && std::find(itr->second.Requesters.begin(), itr->second.Requesters.end(), accountId) == itr->second.Requesters.end())
+        itr->second.Requesters.push_back(accountId);
+}
+
+void World::StoreCharacterInfo(ObjectGuid::LowType guid, PreparedQueryResult const& result) const
+{
+    if (!result)
+    {
+        _characterInfoCache.StoreMissing(guid);
+        return;
+    }
+
+    Field* fields = result->Fetch();
+    _characterInfoCache.Store(guid, fields[1].GetString(), fields[3].GetUInt8() /*gender*/, fields[2].GetUInt8() /*race*/,
+        fields[4].GetUInt8() /*class*/, fields[5].GetUInt8() /*level*/, fields[6].GetUInt32() != 0);
 }
 
 void World::LoadCharacterInfoStore()
 {
     TC_LOG_INFO("server.loading", "Loading character info store");
 
-    _characterInfoStore.clear();
+    _characterInfoCache.Clear();
+    _characterInfoCache.SetCapacity(getIntConfig(CONFIG_CHARACTER_INFO_CACHE_SIZE));
 
-    QueryResult result = CharacterDatabase.Query("SELECT guid, name, race, gender, class, level, deleteDate FROM characters");
+    // with a bounded cache only the most recently played characters are loaded, others are loaded on demand
+    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_INFO_RECENT);
+    stmt->setUInt32(0, _characterInfoCache.GetCapacity() ? _characterInfoCache.GetCapacity() : 0xFFFFFFFF);
+    PreparedQueryResult result = CharacterDatabase.Query(stmt);
     if (!result)
     {
         TC_LOG_INFO("server.loading", "No character name data loaded, empty query");
@@ -3366,39 +3638,24 @@ void World::LoadCharacterInfoStore()
     do
     {
         Field* fields = result->Fetch();
-        AddCharacterInfo(ObjectGuid::Create<HighGuid::Player>(fields[0].GetUInt64()), fields[1].GetString(),
+        _characterInfoCache.Store(fields[0].GetUInt64(), fields[1].GetString(),
             fields[3].GetUInt8() /*gender*/, fields[2].GetUInt8() /*race*/, fields[4].GetUInt8() /*class*/, fields[5].GetUInt8() /*level*/, fields[6].GetUInt32() != 0);
     }
     while (result->NextRow());
 
-    TC_LOG_INFO("server.loading", "Loaded character infos for " SZFMTD " characters", _characterInfoStore.size());
+    TC_LOG_INFO("server.loading", "Loaded character infos for " SZFMTD " characters (" SZFMTD " KB)", _characterInfoCache.GetSize(), _characterInfoCache.GetMemoryUsage() / 1024);
 }
 
 void World::AddCharacterInfo(ObjectGuid const& guid, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level, bool isDeleted)
 {
-    CharacterInfo& data = _characterInfoStore[guid];
-    data.Name = name;
-    data.Race = race;
-    data.Sex = gender;
-    data.Class = playerClass;
-    data.Level = level;
-    data.IsDeleted = isDeleted;
+    _characterInfoCache.Store(guid.GetCounter(), name, gender, race, playerClass, level, isDeleted);
 }
 
 void World::UpdateCharacterInfo(ObjectGuid const& guid, std::string const& name, uint8 gender /*= GENDER_NONE*/, uint8 race /*= RACE_NONE*/)
 {
-    CharacterInfoContainer::iterator itr = _characterInfoStore.find(guid);
-    if (itr == _characterInfoStore.end())
+    if (!_characterInfoCache.UpdateName(guid.GetCounter(), name, gender, race))
         return;
 
-    itr->second.Name = name;
-
-    if (gender != GENDER_NONE)
-        itr->second.Sex = gender;
-
-    if (race != RACE_NONE)
-        itr->second.Race = race;
-
     WorldPackets::Misc::InvalidatePlayer data;
     data.Guid = guid;
     SendGlobalMessage(data.Write());
@@ -3406,23 +3663,12 @@ void World::UpdateCharacterInfo(ObjectGuid const& guid, std::string const& name,
 
 void World::UpdateCharacterInfoLevel(ObjectGuid const& guid, uint8 level)
 {
-    CharacterInfoContainer::iterator itr = _characterInfoStore.find(guid);
-    if (itr == _characterInfoStore.end())
-        return;
-
-    itr->second.Level = level;
+    _characterInfoCache.UpdateLevel(guid.GetCounter(), level);
 }
 
 void World::UpdateCharacterInfoDeleted(ObjectGuid const& guid, bool deleted, std::string const* name /*= nullptr*/)
 {
-    CharacterInfoContainer::iterator itr = _characterInfoStore.find(guid);
-    if (itr == _characterInfoStore.end())
-        return;
-
-    itr->second.IsDeleted = deleted;
-
-    if (name)
-        itr->second.Name = *name;
+    _characterInfoCache.UpdateDeleted(guid.GetCounter(), deleted, name);
 }
 
 void World::UpdatePhaseDefinitions()
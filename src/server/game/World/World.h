@@ -24,6 +24,7 @@
 #define __WORLD_H
 
 #include "Common.h"
+#include "CharacterInfoCache.h"
 #include "Commands.h"
 #include "ObjectGuid.h"
 #include "Timer.h"
@@ -36,6 +37,7 @@
 #include <map>
 #include <set>
 #include <list>
+#include <mutex>
 
 class Object;
 class WorldPacket;
@@ -317,6 +319,8 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_STARTUP_LOADER_THREADS,
+    CONFIG_CHARACTER_INFO_CACHE_SIZE,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -371,6 +375,7 @@ enum WorldIntConfigs
     CONFIG_CHARTER_COST_ARENA_5v5,
     CONFIG_NO_GRAY_AGGRO_ABOVE,
     CONFIG_NO_GRAY_AGGRO_BELOW,
+    CONFIG_EVENT_STAGED_SPAWN_TIME,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -551,16 +556,6 @@ private:
 
 typedef std::unordered_map<uint32, WorldSession*> SessionMap;
 
-struct CharacterInfo
-{
-    std::string Name;
-    uint8 Class;
-    uint8 Race;
-    uint8 Sex;
-    uint8 Level;
-    bool IsDeleted;
-};
-
 /// The World
 class World
 {
@@ -779,10 +774,15 @@ class World
 
         void UpdateAreaDependentAuras();
 
-        CharacterInfo const* GetCharacterInfo(ObjectGuid const& guid) const;
+        bool GetCharacterInfo(ObjectGuid const& guid, CharacterInfo& info) const;
+        /// Returns true if the cache holds an answer for the character, otherwise queues an asynchronous load of it
+        /// and sends the name query response for it to the session of accountId once it is loaded
+        bool GetCharacterInfoAsync(ObjectGuid const& guid, uint32 accountId) const;
         void AddCharacterInfo(ObjectGuid const& guid, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level, bool isDeleted);
-        void DeleteCharacterInfo(ObjectGuid const& guid) { _characterInfoStore.erase(guid); }
-        bool HasCharacterInfo(ObjectGuid const& guid) { return _characterInfoStore.find(guid) != _characterInfoStore.end(); }
+        void DeleteCharacterInfo(ObjectGuid const& guid) { _characterInfoCache.Remove(guid.GetCounter()); }
+        bool HasCharacterInfo(ObjectGuid const& guid) { bool exists; return _characterInfoCache.Find(guid.GetCounter(), exists) && exists; }
+        std::size_t GetCharacterInfoCacheSize() { return _characterInfoCache.GetSize(); }
+        std::size_t GetCharacterInfoCacheMemory() { return _characterInfoCache.GetMemoryUsage(); }
         void UpdateCharacterInfo(ObjectGuid const& guid, std::string const& name, uint8 gender = GENDER_NONE, uint8 race = RACE_NONE);
         void UpdateCharacterInfoLevel(ObjectGuid const& guid, uint8 level);
         void UpdateCharacterInfoDeleted(ObjectGuid const& guid, bool deleted, std::string const* name = nullptr);
@@ -896,12 +896,21 @@ class World
         typedef std::map<uint8, uint8> AutobroadcastsWeightMap;
         AutobroadcastsWeightMap m_AutobroadcastsWeights;
 
-        typedef std::map<ObjectGuid, CharacterInfo> CharacterInfoContainer;
-        CharacterInfoContainer _characterInfoStore;
+        mutable CharacterInfoCache _characterInfoCache;
         void LoadCharacterInfoStore();
+        void StoreCharacterInfo(ObjectGuid::LowType guid, PreparedQueryResult const& result) const;
 
         void ProcessQueryCallbacks();
         std::deque<PreparedQueryResultFuture> m_realmCharCallbacks;
+
+        struct CharacterInfoQuery
+        {
+            PreparedQueryResultFuture Result;
+            std::vector<uint32> Requesters;             // accounts waiting for a name query response
+        };
+        void QueueCharacterInfoQuery(ObjectGuid::LowType guid, uint32 accountId) const;
+        mutable std::unordered_map<ObjectGuid::LowType, CharacterInfoQuery> _characterInfoQueries;
+        mutable std::mutex _characterInfoQueriesLock;   // cache misses are queued from map threads
 };
 
 extern Battlenet::RealmHandle realmHandle;
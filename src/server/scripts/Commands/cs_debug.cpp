@@ -23,6 +23,7 @@ Category: commandscripts
 EndScriptData */
 
 #include "ScriptMgr.h"
+#include "AchievementMgr.h"
 #include "ObjectMgr.h"
 #include "BattlegroundMgr.h"
 #include "Chat.h"
@@ -35,6 +36,7 @@ EndScriptData */
 #include "Language.h"
 #include "MovementPackets.h"
 #include "ScenePackets.h"
+#include "SpellAuras.h"
 
 #include <fstream>
 
@@ -97,6 +99,11 @@ public:
             { "moveflags",     rbac::RBAC_PERM_COMMAND_DEBUG_MOVEFLAGS,     false, &HandleDebugMoveflagsCommand,        "", NULL },
             { "transport",     rbac::RBAC_PERM_COMMAND_DEBUG_TRANSPORT,     false, &HandleDebugTransportCommand,        "", NULL },
             { "phase",         rbac::RBAC_PERM_COMMAND_DEBUG_PHASE,         false, &HandleDebugPhaseCommand,            "", NULL },
+            { "auraupdates",   rbac::RBAC_PERM_COMMAND_DEBUG_AURAUPDATES,   true,  &HandleDebugAuraUpdatesCommand,      "", NULL },
+            { "procstats",     rbac::RBAC_PERM_COMMAND_DEBUG_PROCSTATS,     true,  &HandleDebugProcStatsCommand,        "", NULL },
+            { "packetstats",   rbac::RBAC_PERM_COMMAND_DEBUG_PACKETSTATS,   true,  &HandleDebugPacketStatsCommand,      "", NULL },
+            { "charcache",     rbac::RBAC_PERM_COMMAND_DEBUG_CHARCACHE,     true,  &HandleDebugCharCacheCommand,        "", NULL },
+            { "achievementstats", rbac::RBAC_PERM_COMMAND_DEBUG_ACHIEVEMENTSTATS, true, &HandleDebugAchievementStatsCommand, "", NULL },
             { NULL,            0,                                     false, NULL,                                "", NULL }
         };
         static ChatCommand commandTable[] =
@@ -1431,6 +1438,96 @@ public:
             handler->SendSysMessage("Target is not phased");
         return true;
     }
+
+    static bool HandleDebugAuraUpdatesCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        AuraUpdateStatistics const& stats = Aura::GetUpdateStatistics();
+        uint64 updated = stats.Updated;
+        uint64 skipped = stats.Skipped;
+
+        handler->PSendSysMessage("Owned aura updates since startup:");
+        handler->PSendSysMessage(" Updated: " UI64FMTD, updated);
+        handler->PSendSysMessage(" Skipped while sleeping: " UI64FMTD, skipped);
+        handler->PSendSysMessage(" Woken up early: " UI64FMTD, uint64(stats.WokenUp));
+        if (updated + skipped)
+            handler->PSendSysMessage(" Skipped ratio: %.2f%%", float(skipped) * 100.0f / float(updated + skipped));
+        return true;
+    }
+
+    static bool HandleDebugProcStatsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        ProcAuraStatistics const& stats = Unit::GetProcAuraStatistics();
+        uint64 events = stats.Events;
+        uint64 evaluated = stats.Evaluated;
+
+        handler->PSendSysMessage("Proc events since startup: " UI64FMTD, events);
+        handler->PSendSysMessage(" Auras evaluated: " UI64FMTD, evaluated);
+        handler->PSendSysMessage(" Auras skipped by proc flags: " UI64FMTD, uint64(stats.Skipped));
+        if (events)
+            handler->PSendSysMessage(" Auras evaluated per event: %.2f", float(evaluated) / float(events));
+        return true;
+    }
+
+    static bool HandleDebugPacketStatsCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = 10;
+        if (*args)
+            count = atoi(args);
+
+        ByteBufferPoolStatistics const& pool = ByteBuffer::GetPoolStatistics();
+        handler->PSendSysMessage("Packet storage allocated: " UI64FMTD " reused: " UI64FMTD " released to pool: " UI64FMTD,
+            uint64(pool.Allocated), uint64(pool.Reused), uint64(pool.Released));
+
+        std::vector<std::pair<uint64, uint32>> opcodes;
+        for (uint32 opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+            if (uint64 created = WorldPacket::GetOpcodeStatistics(opcode)->Created)
+                opcodes.push_back(std::make_pair(created, opcode));
+
+        std::sort(opcodes.begin(), opcodes.end(), std::greater<std::pair<uint64, uint32>>());
+        if (opcodes.size() > count)
+            opcodes.resize(count);
+
+        for (std::pair<uint64, uint32> const& itr : opcodes)
+        {
+            OpcodeAllocationStatistics const* stats = WorldPacket::GetOpcodeStatistics(itr.second);
+            uint64 sent = stats->Sent;
+            handler->PSendSysMessage("%s created: " UI64FMTD " allocated: " UI64FMTD " sent: " UI64FMTD " avg size: " UI64FMTD " reserve: %u",
+                GetOpcodeNameForLogging(static_cast<OpcodeServer>(itr.second)).c_str(), itr.first, uint64(stats->Allocated), sent,
+                sent ? uint64(stats->SentBytes) / sent : uint64(0), uint32(stats->LearnedSize));
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugCharCacheCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        CharacterInfoCacheStatistics const& stats = CharacterInfoCache::GetStatistics();
+        uint64 hits = stats.Hits;
+        uint64 misses = stats.Misses;
+
+        handler->PSendSysMessage("Character info cache: " SZFMTD " characters, " SZFMTD " KB (limit %u)",
+            sWorld->GetCharacterInfoCacheSize(), sWorld->GetCharacterInfoCacheMemory() / 1024, sWorld->getIntConfig(CONFIG_CHARACTER_INFO_CACHE_SIZE));
+        handler->PSendSysMessage(" Hits: " UI64FMTD " misses: " UI64FMTD, hits, misses);
+        handler->PSendSysMessage(" Loaded on demand: " UI64FMTD " (" UI64FMTD " blocking), evicted: " UI64FMTD,
+            uint64(stats.SyncFills + stats.AsyncFills), uint64(stats.SyncFills), uint64(stats.Evictions));
+        if (hits + misses)
+            handler->PSendSysMessage(" Hit rate: %.2f%%", float(hits) * 100.0f / float(hits + misses));
+        return true;
+    }
+
+    static bool HandleDebugAchievementStatsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        AchievementCriteriaUpdateStatistics const& stats = sAchievementMgr->GetCriteriaUpdateStatistics();
+        uint64 updates = stats.Updates;
+        uint64 evaluated = stats.Evaluated;
+
+        handler->PSendSysMessage("Achievement criteria updates: " UI64FMTD ", criteria evaluated: " UI64FMTD, updates, evaluated);
+        handler->PSendSysMessage(" Skipped by asset index: " UI64FMTD " already completed: " UI64FMTD,
+            uint64(stats.SkippedByAsset), uint64(stats.SkippedCompleted));
+        if (updates)
+            handler->PSendSysMessage(" Criteria evaluated per update: %.2f", float(evaluated) / float(updates));
+        return true;
+    }
     
     static bool HandleDebugSendPlaySceneCommand(ChatHandler* handler, char const* args)
     {
@@ -126,6 +126,10 @@ public:
         handler->PSendSysMessage(LANG_EVENT_INFO, eventId, eventData.description.c_str(), activeStr,
             startTimeStr.c_str(), endTimeStr.c_str(), occurenceStr.c_str(), lengthStr.c_str(),
             nextStr.c_str());
+
+        if (uint32 staged = sGameEventMgr->GetStagedSpawnCount(eventId))
+            handler->PSendSysMessage("Objects waiting for their map to spawn them: %u", staged);
+
         return true;
     }
 
@@ -215,6 +215,12 @@ public:
         MMAP::MMapManager* manager = MMAP::MMapFactory::createOrGetMMapManager();
         handler->PSendSysMessage(" %u maps loaded with %u tiles overall", manager->getLoadedMapsCount(), manager->getLoadedTilesCount());
 
+        PathfindingStatistics const& pathStats = PathGenerator::GetStatistics();
+        handler->PSendSysMessage("Path calculations:");
+        handler->PSendSysMessage(" " UI64FMTD " full, " UI64FMTD " suffix, " UI64FMTD " corridor moved, " UI64FMTD " shared",
+            uint64(pathStats.FullPaths), uint64(pathStats.SuffixPaths), uint64(pathStats.CorridorPaths), uint64(pathStats.SharedPaths));
+        handler->PSendSysMessage(" " UI64FMTD " point paths cut by their length limit", uint64(pathStats.LimitedPaths));
+
         dtNavMesh const* navmesh = manager->GetNavMesh(handler->GetSession()->GetPlayer()->GetMapId(), handler->GetSession()->GetPlayer()->GetTerrainSwaps());
         if (!navmesh)
         {
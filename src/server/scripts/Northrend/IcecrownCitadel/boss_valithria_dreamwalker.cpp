@@ -557,7 +557,7 @@ class npc_green_dragon_combat_trigger : public CreatureScript
                 if (!me->IsInCombat())
                     return;
 
-                std::list<HostileReference*> const& threatList = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType const& threatList = me->getThreatManager().getThreatList();
                 if (threatList.empty())
                 {
                     EnterEvadeMode();
@@ -570,7 +570,7 @@ class npc_green_dragon_combat_trigger : public CreatureScript
                     return;
 
                 // check if there is any player on threatlist, if not - evade
-                for (std::list<HostileReference*>::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
+                for (ThreatContainer::StorageType::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
                     if (Unit* target = (*itr)->getTarget())
                         if (target->GetTypeId() == TYPEID_PLAYER)
                             return; // found any player, return
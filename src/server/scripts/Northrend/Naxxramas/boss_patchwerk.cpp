@@ -115,7 +115,7 @@ public:
                         //amount of HP within melee distance
                         uint32 MostHP = 0;
                         Unit* pMostHPTarget = NULL;
-                        std::list<HostileReference*>::const_iterator i = me->getThreatManager().getThreatList().begin();
+                        ThreatContainer::StorageType::const_iterator i = me->getThreatManager().getThreatList().begin();
                         for (; i != me->getThreatManager().getThreatList().end(); ++i)
                         {
                             Unit* target = (*i)->getTarget();
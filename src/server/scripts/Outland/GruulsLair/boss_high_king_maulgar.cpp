@@ -556,9 +556,9 @@ public:
             if (BlastWave_Timer <= diff)
             {
                 Unit* target = NULL;
-                std::list<HostileReference*> t_list = me->getThreatManager().getThreatList();
+                ThreatContainer::StorageType t_list = me->getThreatManager().getThreatList();
                 std::vector<Unit*> target_list;
-                for (std::list<HostileReference*>::const_iterator itr = t_list.begin(); itr!= t_list.end(); ++itr)
+                for (ThreatContainer::StorageType::const_iterator itr = t_list.begin(); itr!= t_list.end(); ++itr)
                 {
                     target = ObjectAccessor::GetUnit(*me, (*itr)->getUnitGuid());
                                                                 //15 yard radius minimum
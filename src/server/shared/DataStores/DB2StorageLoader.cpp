@@ -29,6 +29,8 @@ DB2FileLoader::DB2FileLoader()
     fieldsOffset = NULL;
     data = NULL;
     stringTable = NULL;
+    file = NULL;
+    allocatedSize = 0;
 
     tableHash = 0;
     build = 0;
@@ -42,125 +44,64 @@ DB2FileLoader::DB2FileLoader()
 
 bool DB2FileLoader::Load(const char *filename, const char *fmt)
 {
-    if (data)
-    {
-        delete [] data;
-        data = NULL;
-    }
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    uint32 header;
-    if (fread(&header, 4, 1, f) != 1)                        // Signature
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(header);
-
-    if (header != 0x32424457)
-    {
-        fclose(f);
-        return false;                                       //'WDB2'
-    }
-
-    if (fread(&recordCount, 4, 1, f) != 1)                 // Number of records
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(recordCount);
-
-    if (fread(&fieldCount, 4, 1, f) != 1)                 // Number of fields
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(fieldCount);
-
-    if (fread(&recordSize, 4, 1, f) != 1)                 // Size of a record
-    {
-        fclose(f);
-        return false;
-    }
+    data = NULL;
+    stringTable = NULL;
+    delete[] fieldsOffset;
+    fieldsOffset = NULL;
 
-    EndianConvert(recordSize);
+    if (!file)
+        file = new MappedDataFile();
 
-    if (fread(&stringSize, 4, 1, f) != 1)                 // String size
-    {
-        fclose(f);
+    if (!file->Open(filename))
         return false;
-    }
-
-    EndianConvert(stringSize);
 
-    /* NEW WDB2 FIELDS*/
-    if (fread(&tableHash, 4, 1, f) != 1)                  // Table hash
-    {
-        fclose(f);
+    std::size_t const baseHeaderSize = 8 * sizeof(uint32);
+    std::size_t const extendedHeaderSize = 12 * sizeof(uint32);
+    if (file->GetSize() < baseHeaderSize)
         return false;
-    }
 
-    EndianConvert(tableHash);
+    uint32 header[12];
+    memcpy(header, file->GetData(), baseHeaderSize);
+    for (uint32 i = 0; i < 8; ++i)
+        EndianConvert(header[i]);
 
-    if (fread(&build, 4, 1, f) != 1)                     // Build
-    {
-        fclose(f);
+    if (header[0] != 0x32424457)                            //'WDB2'
         return false;
-    }
 
-    EndianConvert(build);
-
-    if (fread(&unk1, 4, 1, f) != 1)                     // Unknown WDB2
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(unk1);
+    recordCount = header[1];                                // Number of records
+    fieldCount = header[2];                                 // Number of fields
+    recordSize = header[3];                                 // Size of a record
+    stringSize = header[4];                                 // String size
+    tableHash = header[5];                                  // Table hash
+    build = header[6];                                      // Build
+    unk1 = int(header[7]);                                  // Unknown WDB2
 
+    std::size_t offset = baseHeaderSize;
     if (build > 12880)
     {
-        if (fread(&minIndex, 4, 1, f) != 1)                           // MinIndex WDB2
-        {
-            fclose(f);
+        if (file->GetSize() < extendedHeaderSize)
             return false;
-        }
-        EndianConvert(minIndex);
-
-        if (fread(&maxIndex, 4, 1, f) != 1)                           // MaxIndex WDB2
-        {
-            fclose(f);
-            return false;
-        }
-        EndianConvert(maxIndex);
 
-        if (fread(&locale, 4, 1, f) != 1)                             // Locales
-        {
-            fclose(f);
-            return false;
-        }
-        EndianConvert(locale);
+        memcpy(&header[8], file->GetData() + baseHeaderSize, extendedHeaderSize - baseHeaderSize);
+        for (uint32 i = 8; i < 12; ++i)
+            EndianConvert(header[i]);
 
-        if (fread(&unk5, 4, 1, f) != 1)                               // Unknown WDB2
-        {
-            fclose(f);
-            return false;
-        }
-        EndianConvert(unk5);
+        minIndex = int(header[8]);                          // MinIndex WDB2
+        maxIndex = int(header[9]);                          // MaxIndex WDB2
+        locale = int(header[10]);                           // Locales
+        unk5 = int(header[11]);                             // Unknown WDB2
+        offset = extendedHeaderSize;
     }
 
     if (maxIndex != 0)
     {
         int32 diff = maxIndex - minIndex + 1;
-        fseek(f, diff * 4 + diff * 2, SEEK_CUR);    // diff * 4: an index for rows, diff * 2: a memory allocation bank
+        offset += diff * 4 + diff * 2;                      // diff * 4: an index for rows, diff * 2: a memory allocation bank
     }
 
+    if (!fieldCount || file->GetSize() < offset + std::size_t(recordSize) * recordCount + stringSize)
+        return false;
+
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; i++)
@@ -172,27 +113,28 @@ bool DB2FileLoader::Load(const char *filename, const char *fmt)
             fieldsOffset[i] += 4;
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = file->GetData() + offset;
     stringTable = data + recordSize * recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
     return true;
 }
 
 DB2FileLoader::~DB2FileLoader()
 {
-    if (data)
-        delete [] data;
+    delete file;
     if (fieldsOffset)
         delete [] fieldsOffset;
 }
 
+MappedDataFile* DB2FileLoader::ReleaseFile()
+{
+    MappedDataFile* released = file;
+    file = NULL;
+    data = NULL;
+    stringTable = NULL;
+    return released;
+}
+
 DB2FileLoader::Record DB2FileLoader::getRecord(size_t id)
 {
     assert(data);
@@ -243,6 +185,29 @@ uint32 DB2FileLoader::GetFormatStringFieldCount(char const* format)
     return stringfields;
 }
 
+bool DB2FileLoader::IsInPlaceFormat(const char* format)
+{
+#if TRINITY_ENDIAN == TRINITY_LITTLEENDIAN
+    for (uint32 x = 0; format[x]; ++x)
+    {
+        switch (format[x])
+        {
+            case FT_FLOAT:
+            case FT_INT:
+            case FT_IND:
+            case FT_BYTE:
+                break;
+            default:                                        // strings become LocalizedString pointers
+                return false;
+        }
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
 char* DB2FileLoader::AutoProduceData(const char* format, uint32& records, char**& indexTable)
 {
     typedef char * ptr;
@@ -275,7 +240,26 @@ char* DB2FileLoader::AutoProduceData(const char* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    allocatedSize += records * sizeof(ptr);
+
+    // Records laid out in the file exactly like in memory are used directly from the file,
+    // hotfixes overwriting them only make private copies of the touched pages
+    if (recordsize == recordSize && IsInPlaceFormat(format))
+    {
+        for (uint32 y = 0; y < recordCount; y++)
+        {
+            char* record = reinterpret_cast<char*>(data + y * recordSize);
+            if (indexField >= 0)
+                indexTable[getRecord(y).getUInt(indexField)] = record;
+            else
+                indexTable[y] = record;
+        }
+
+        return nullptr;
+    }
+
     char* dataTable = new char[recordCount * recordsize];
+    allocatedSize += recordCount * recordsize;
 
     uint32 offset = 0;
 
@@ -332,6 +316,7 @@ char* DB2FileLoader::AutoProduceStringsArrayHolders(const char* format, char* da
     size_t stringHoldersPoolSize = stringHoldersRecordPoolSize * recordCount;
 
     char* stringHoldersPool = new char[stringHoldersPoolSize];
+    allocatedSize += stringHoldersPoolSize;
 
     // DB2 strings expected to have at least empty string
     for (size_t i = 0; i < stringHoldersPoolSize / sizeof(char*); ++i)
@@ -380,9 +365,6 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, uin
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
-
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; y++)
@@ -404,10 +386,7 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, uin
                     // fill only not filled entries
                     LocalizedString* db2str = *(LocalizedString**)(&dataTable[offset]);
                     if (db2str->Str[locale] == nullStr)
-                    {
-                        const char * st = getRecord(y).getString(x);
-                        db2str->Str[locale] = stringPool + (st - (const char*)stringTable);
-                    }
+                        db2str->Str[locale] = getRecord(y).getString(x);
 
                     offset += sizeof(char*);
                     break;
@@ -416,7 +395,8 @@ char* DB2FileLoader::AutoProduceStrings(const char* format, char* dataTable, uin
         }
     }
 
-    return stringPool;
+    // strings are used directly from the file, see ReleaseFile
+    return reinterpret_cast<char*>(stringTable);
 }
 
 char* DB2DatabaseLoader::Load(const char* format, uint32 preparedStatement, uint32& records, char**& indexTable, char*& stringHolders, std::list<char*>& stringPool)
@@ -445,6 +425,7 @@ char* DB2DatabaseLoader::Load(const char* format, uint32 preparedStatement, uint
     {
         size_t stringHoldersPoolSize = stringHoldersRecordPoolSize * result->GetRowCount();
         stringHolders = new char[stringHoldersPoolSize];
+        _allocatedSize += stringHoldersPoolSize;
 
         // DB2 strings expected to have at least empty string
         for (size_t i = 0; i < stringHoldersPoolSize / sizeof(char*); ++i)
@@ -472,6 +453,7 @@ char* DB2DatabaseLoader::Load(const char* format, uint32 preparedStatement, uint
         memcpy(tmpIdxTable, indexTable, records * sizeof(char*));
         delete[] indexTable;
         indexTable = tmpIdxTable;
+        _allocatedSize += (indexTableSize - records) * sizeof(char*);
     }
 
     char* tempDataTable = new char[result->GetRowCount() * recordSize];
@@ -524,7 +506,10 @@ char* DB2DatabaseLoader::Load(const char* format, uint32 preparedStatement, uint
 
                     // Value in database in main table field must be for enUS locale
                     if (char* str = AddLocaleString(*slot, LOCALE_enUS, fields[f].GetString()))
+                    {
                         stringPool.push_back(str);
+                        _allocatedSize += strlen(str) + 1;
+                    }
 
                     ++stringFieldNumInRecord;
                     offset += sizeof(char*);
@@ -547,6 +532,7 @@ char* DB2DatabaseLoader::Load(const char* format, uint32 preparedStatement, uint
     // Compact new data table to only contain new records not previously loaded from file
     char* dataTable = new char[newRecords * recordSize];
     memcpy(dataTable, tempDataTable, newRecords * recordSize);
+    _allocatedSize += newRecords * recordSize;
 
     // insert new records to index table
     for (uint32 i = 0; i < newRecords; ++i)
@@ -604,8 +590,13 @@ void DB2DatabaseLoader::LoadStrings(const char* format, uint32 preparedStatement
                         // fill only not filled entries
                         LocalizedString* db2str = *(LocalizedString**)(&dataValue[offset]);
                         if (db2str->Str[locale] == nullStr)
+                        {
                             if (char* str = AddLocaleString(db2str, locale, fields[1 + stringFieldNumInRecord].GetString()))
+                            {
                                 stringPool.push_back(str);
+                                _allocatedSize += strlen(str) + 1;
+                            }
+                        }
 
                         ++stringFieldNumInRecord;
                         offset += sizeof(char*);
@@ -19,6 +19,7 @@
 #define DB2_FILE_LOADER_H
 
 #include "Define.h"
+#include "MappedDataFile.h"
 #include "Utilities/ByteConverter.h"
 
 #include <cassert>
@@ -85,6 +86,13 @@ class DB2FileLoader
     char* AutoProduceStrings(const char* fmt, char* dataTable, uint32 locale);
     static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     static uint32 GetFormatStringFieldCount(const char * format);
+    /// True if records of this format have the same layout in file and in memory and can be used directly from the file
+    static bool IsInPlaceFormat(const char* format);
+
+    /// Bytes allocated by AutoProduceData and AutoProduceStringsArrayHolders
+    std::size_t GetAllocatedSize() const { return allocatedSize; }
+    /// Hands the file over to the caller, produced tables point into it and it must outlive them
+    MappedDataFile* ReleaseFile();
 private:
 
     uint32 recordSize;
@@ -94,6 +102,8 @@ private:
     uint32 *fieldsOffset;
     unsigned char *data;
     unsigned char *stringTable;
+    MappedDataFile* file;
+    std::size_t allocatedSize;
 
     // WDB2 / WCH2 fields
     uint32 tableHash;    // WDB2
@@ -109,14 +119,18 @@ private:
 class DB2DatabaseLoader
 {
 public:
-    explicit DB2DatabaseLoader(std::string const& storageName) : _storageName(storageName) { }
+    explicit DB2DatabaseLoader(std::string const& storageName) : _storageName(storageName), _allocatedSize(0) { }
 
     char* Load(const char* format, uint32 preparedStatement, uint32& records, char**& indexTable, char*& stringHolders, std::list<char*>& stringPool);
     void LoadStrings(const char* format, uint32 preparedStatement, uint32 locale, char**& indexTable, std::list<char*>& stringPool);
     static char* AddLocaleString(LocalizedString* holder, uint32 locale, std::string const& value);
 
+    /// Bytes allocated for hotfixed records and strings
+    std::size_t GetAllocatedSize() const { return _allocatedSize; }
+
 private:
     std::string _storageName;
+    std::size_t _allocatedSize;
 };
 
 #endif
@@ -45,11 +45,13 @@ template<class T>
 class DB2Storage : public DB2StorageBase
 {
     typedef std::list<char*> StringPoolList;
+    typedef std::list<MappedDataFile*> DataFileList;
 public:
     typedef DBStorageIterator<T> iterator;
 
     DB2Storage(char const* fileName, char const* format, uint32 preparedStmtIndex)
-        : _fileName(fileName), _indexTableSize(0), _fieldCount(0), _format(format), _dataTable(nullptr), _dataTableEx(nullptr), _hotfixStatement(preparedStmtIndex)
+        : _fileName(fileName), _indexTableSize(0), _fieldCount(0), _format(format), _dataTable(nullptr), _dataTableEx(nullptr), _hotfixStatement(preparedStmtIndex),
+        _allocatedMemory(0), _mappedMemory(0)
     {
         _indexTable.AsT = NULL;
     }
@@ -61,6 +63,8 @@ public:
         delete[] reinterpret_cast<char*>(_dataTableEx);
         for (char* stringPool : _stringPoolList)
             delete[] stringPool;
+        for (MappedDataFile* file : _dataFiles)
+            delete file;
     }
 
     bool HasRecord(uint32 id) const override { return id < _indexTableSize && _indexTable.AsT[id] != nullptr; }
@@ -118,6 +122,10 @@ public:
     uint32 GetNumRows() const { return _indexTableSize; }
     char const* GetFormat() const { return _format; }
     uint32 GetFieldCount() const { return _fieldCount; }
+    /// Private memory used by the store: index tables, copied and hotfixed records and strings
+    std::size_t GetAllocatedMemory() const { return _allocatedMemory; }
+    /// Memory mapped from db2 files, shared with every process using the same files
+    std::size_t GetMappedMemory() const { return _mappedMemory; }
     bool Load(std::string const& path, uint32 locale)
     {
         DB2FileLoader db2;
@@ -137,10 +145,12 @@ public:
             _stringPoolList.push_back(stringHolders);
 
             // load strings from db2 data
-            if (char* stringBlock = db2.AutoProduceStrings(_format, (char*)_dataTable, locale))
-                _stringPoolList.push_back(stringBlock);
+            db2.AutoProduceStrings(_format, (char*)_dataTable, locale);
         }
 
+        _allocatedMemory += db2.GetAllocatedSize();
+        AddDataFile(db2.ReleaseFile());
+
         // error in db2 file at loading if NULL
         return _indexTable.AsT != NULL;
     }
@@ -158,17 +168,23 @@ public:
 
         // load strings from another locale db2 data
         if (DB2FileLoader::GetFormatStringFieldCount(_format))
-            if (char* stringBlock = db2.AutoProduceStrings(_format, (char*)_dataTable, locale))
-                _stringPoolList.push_back(stringBlock);
+        {
+            db2.AutoProduceStrings(_format, (char*)_dataTable, locale);
+            AddDataFile(db2.ReleaseFile());
+        }
+
         return true;
     }
 
     void LoadFromDB()
     {
         char* extraStringHolders = nullptr;
-        if (char* dataTable = DB2DatabaseLoader(_fileName).Load(_format, _hotfixStatement, _indexTableSize, _indexTable.AsChar, extraStringHolders, _stringPoolList))
+        DB2DatabaseLoader loader(_fileName);
+        if (char* dataTable = loader.Load(_format, _hotfixStatement, _indexTableSize, _indexTable.AsChar, extraStringHolders, _stringPoolList))
             _dataTableEx = reinterpret_cast<T*>(dataTable);
 
+        _allocatedMemory += loader.GetAllocatedSize();
+
         if (extraStringHolders)
             _stringPoolList.push_back(extraStringHolders);
     }
@@ -178,13 +194,25 @@ public:
         if (!DB2FileLoader::GetFormatStringFieldCount(_format))
             return;
 
-        DB2DatabaseLoader(_fileName).LoadStrings(_format, _hotfixStatement + 1, locale, _indexTable.AsChar, _stringPoolList);
+        DB2DatabaseLoader loader(_fileName);
+        loader.LoadStrings(_format, _hotfixStatement + 1, locale, _indexTable.AsChar, _stringPoolList);
+        _allocatedMemory += loader.GetAllocatedSize();
     }
 
     iterator begin() { return iterator(_indexTable.AsT, _indexTableSize); }
     iterator end() { return iterator(_indexTable.AsT, _indexTableSize, _indexTableSize); }
 
 private:
+    void AddDataFile(MappedDataFile* file)
+    {
+        if (file->IsMapped())
+            _mappedMemory += file->GetSize();
+        else
+            _allocatedMemory += file->GetSize();
+
+        _dataFiles.push_back(file);
+    }
+
     std::string _fileName;
     uint32 _indexTableSize;
     uint32 _fieldCount;
@@ -197,7 +225,10 @@ private:
     T* _dataTable;
     T* _dataTableEx;
     StringPoolList _stringPoolList;
+    DataFileList _dataFiles;
     uint32 _hotfixStatement;
+    std::size_t _allocatedMemory;
+    std::size_t _mappedMemory;
 };
 
 #endif
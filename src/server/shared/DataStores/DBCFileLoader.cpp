@@ -23,67 +23,40 @@
 #include "DBCFileLoader.h"
 #include "Errors.h"
 
-DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(NULL), data(NULL), stringTable(NULL) { }
+DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(NULL), data(NULL), stringTable(NULL), file(NULL), allocatedSize(0) { }
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = NULL;
-    }
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-        return false;
-
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
-    {
-        fclose(f);
-        return false;
-    }
-
+    data = NULL;
+    stringTable = NULL;
+    delete[] fieldsOffset;
+    fieldsOffset = NULL;
 
-    EndianConvert(header);
+    if (!file)
+        file = new MappedDataFile();
 
-    if (header != 0x43424457)                                //'WDBC'
-    {
-        fclose(f);
+    if (!file->Open(filename))
         return false;
-    }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
-    {
-        fclose(f);
+    uint32 const headerSize = 5 * sizeof(uint32);
+    if (file->GetSize() < headerSize)
         return false;
-    }
 
-    EndianConvert(recordCount);
+    uint32 header[5];
+    memcpy(header, file->GetData(), headerSize);
+    for (uint32 i = 0; i < 5; ++i)
+        EndianConvert(header[i]);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
+    if (header[0] != 0x43424457)                             //'WDBC'
         return false;
-    }
 
-    EndianConvert(fieldCount);
+    recordCount = header[1];                                 // Number of records
+    fieldCount = header[2];                                  // Number of fields
+    recordSize = header[3];                                  // Size of a record
+    stringSize = header[4];                                  // String size
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(recordSize);
-
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
+    if (!fieldCount || file->GetSize() < headerSize + std::size_t(recordSize) * recordCount + stringSize)
         return false;
-    }
-
-    EndianConvert(stringSize);
 
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
@@ -98,27 +71,28 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = file->GetData() + headerSize;
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
+    delete file;
 
     delete[] fieldsOffset;
 }
 
+MappedDataFile* DBCFileLoader::ReleaseFile()
+{
+    MappedDataFile* released = file;
+    file = NULL;
+    data = NULL;
+    stringTable = NULL;
+    return released;
+}
+
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
 {
     assert(data);
@@ -170,6 +144,30 @@ uint32 DBCFileLoader::GetFormatRecordSize(const char* format, int32* index_pos)
     return recordsize;
 }
 
+bool DBCFileLoader::IsInPlaceFormat(const char* format)
+{
+#if TRINITY_ENDIAN == TRINITY_LITTLEENDIAN
+    for (uint32 x = 0; format[x]; ++x)
+    {
+        switch (format[x])
+        {
+            case FT_FLOAT:
+            case FT_INT:
+            case FT_IND:
+            case FT_BYTE:
+            case FT_LONG:
+                break;
+            default:                                        // strings become pointers, skipped fields are not stored
+                return false;
+        }
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
 char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char*& sqlDataTable)
 {
     /*
@@ -217,7 +215,28 @@ char* DBCFileLoader::AutoProduceData(const char* format, uint32& records, char**
         indexTable = new ptr[recordCount + sqlRecordCount];
     }
 
+    allocatedSize += records * sizeof(ptr);
+
+    // Records laid out in the file exactly like in memory are used directly from the file,
+    // only rows coming from sql need a table of their own
+    if (recordsize == recordSize && IsInPlaceFormat(format))
+    {
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            char* record = reinterpret_cast<char*>(data + y * recordSize);
+            if (i >= 0)
+                indexTable[getRecord(y).getUInt(i)] = record;
+            else
+                indexTable[y] = record;
+        }
+
+        sqlDataTable = new char[sqlRecordCount * recordsize];
+        allocatedSize += sqlRecordCount * recordsize;
+        return sqlDataTable;
+    }
+
     char* dataTable = new char[(recordCount + sqlRecordCount) * recordsize];
+    allocatedSize += (recordCount + sqlRecordCount) * recordsize;
 
     uint32 offset = 0;
 
@@ -274,8 +293,8 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    // strings are used directly from the file, see ReleaseFile
+    char* stringPool = reinterpret_cast<char*>(stringTable);
 
     uint32 offset = 0;
 
@@ -304,8 +323,7 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !**slot)
                     {
-                        const char * st = getRecord(y).getString(x);
-                        *slot=stringPool+(st-(const char*)stringTable);
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     }
                     offset += sizeof(char*);
                     break;
@@ -20,6 +20,7 @@
 #define DBC_FILE_LOADER_H
 
 #include "Define.h"
+#include "MappedDataFile.h"
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
@@ -88,6 +89,13 @@ class DBCFileLoader
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char *& sqlDataTable);
         char* AutoProduceStrings(const char* fmt, char* dataTable);
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
+        /// True if records of this format have the same layout in file and in memory and can be used directly from the file
+        static bool IsInPlaceFormat(const char* format);
+
+        /// Bytes allocated by AutoProduceData for index and data tables
+        std::size_t GetAllocatedSize() const { return allocatedSize; }
+        /// Hands the file over to the caller, produced tables point into it and it must outlive them
+        MappedDataFile* ReleaseFile();
     private:
 
         uint32 recordSize;
@@ -97,6 +105,8 @@ class DBCFileLoader
         uint32 *fieldsOffset;
         unsigned char *data;
         unsigned char *stringTable;
+        MappedDataFile* file;
+        std::size_t allocatedSize;
 
         DBCFileLoader(DBCFileLoader const& right) = delete;
         DBCFileLoader& operator=(DBCFileLoader const& right) = delete;
@@ -73,13 +73,13 @@ private:
 template<class T>
 class DBCStorage
 {
-        typedef std::list<char*> StringPoolList;
+        typedef std::list<MappedDataFile*> DataFileList;
 
     public:
         typedef DBStorageIterator<T> iterator;
 
         explicit DBCStorage(char const* f)
-            : fmt(f), nCount(0), fieldCount(0), dataTable(NULL)
+            : fmt(f), nCount(0), fieldCount(0), dataTable(NULL), allocatedMemory(0), mappedMemory(0)
         {
             indexTable.asT = NULL;
         }
@@ -101,6 +101,10 @@ class DBCStorage
         uint32  GetNumRows() const { return nCount; }
         char const* GetFormat() const { return fmt; }
         uint32 GetFieldCount() const { return fieldCount; }
+        /// Private memory used by the store: index tables, copied records and strings
+        std::size_t GetAllocatedMemory() const { return allocatedMemory; }
+        /// Memory mapped from dbc files, shared with every process using the same files
+        std::size_t GetMappedMemory() const { return mappedMemory; }
 
         bool Load(char const* fn, SqlDbc* sql)
         {
@@ -147,7 +151,9 @@ class DBCStorage
             dataTable = reinterpret_cast<T*>(dbc.AutoProduceData(fmt, nCount, indexTable.asChar,
                 sqlRecordCount, sqlHighestIndex, sqlDataTable));
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable)));
+            char* stringPool = dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable));
+            allocatedMemory += dbc.GetAllocatedSize();
+            AddDataFile(dbc.ReleaseFile());
 
             // Insert sql data into arrays
             if (result)
@@ -203,7 +209,7 @@ class DBCStorage
                                         break;
                                     case FT_STRING:
                                         // Beginning of the pool - empty string
-                                        *reinterpret_cast<char**>(&sqlDataTable[offset]) = stringPoolList.back();
+                                        *reinterpret_cast<char**>(&sqlDataTable[offset]) = stringPool;
                                         offset += sizeof(char*);
                                         break;
                                 }
@@ -276,13 +282,23 @@ class DBCStorage
             if (!dbc.Load(fn, fmt))
                 return false;
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable)));
+            dbc.AutoProduceStrings(fmt, reinterpret_cast<char*>(dataTable));
+            AddDataFile(dbc.ReleaseFile());
 
             return true;
         }
 
         void Clear()
         {
+            while (!dataFiles.empty())
+            {
+                delete dataFiles.front();
+                dataFiles.pop_front();
+            }
+
+            allocatedMemory = 0;
+            mappedMemory = 0;
+
             if (!indexTable.asT)
                 return;
 
@@ -291,12 +307,6 @@ class DBCStorage
             delete[] reinterpret_cast<char*>(dataTable);
             dataTable = NULL;
 
-            while (!stringPoolList.empty())
-            {
-                delete[] stringPoolList.front();
-                stringPoolList.pop_front();
-            }
-
             nCount = 0;
         }
 
@@ -304,6 +314,16 @@ class DBCStorage
         iterator end() { return iterator(indexTable.asT, nCount, nCount); }
 
     private:
+        void AddDataFile(MappedDataFile* file)
+        {
+            if (file->IsMapped())
+                mappedMemory += file->GetSize();
+            else
+                allocatedMemory += file->GetSize();
+
+            dataFiles.push_back(file);
+        }
+
         char const* fmt;
         uint32 nCount;
         uint32 fieldCount;
@@ -316,7 +336,9 @@ class DBCStorage
         indexTable;
 
         T* dataTable;
-        StringPoolList stringPoolList;
+        DataFileList dataFiles;
+        std::size_t allocatedMemory;
+        std::size_t mappedMemory;
 
         DBCStorage(DBCStorage const& right) = delete;
         DBCStorage& operator=(DBCStorage const& right) = delete;
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MappedDataFile.h"
+#include <stdio.h>
+
+#if PLATFORM == PLATFORM_WINDOWS
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+bool MappedDataFile::Open(char const* fileName)
+{
+    Close();
+
+#if PLATFORM == PLATFORM_WINDOWS
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER mappedSize;
+    if (GetFileSizeEx(file, &mappedSize) && mappedSize.QuadPart > 0)
+    {
+        // the view keeps the mapping alive, both handles can be closed right away
+        if (HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL))
+        {
+            _data = static_cast<unsigned char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+
+    CloseHandle(file);
+
+    if (_data)
+    {
+        _size = std::size_t(mappedSize.QuadPart);
+        _mapped = true;
+        return true;
+    }
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        void* view = mmap(NULL, std::size_t(fileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED)
+        {
+            _data = static_cast<unsigned char*>(view);
+            _size = std::size_t(fileStat.st_size);
+            _mapped = true;
+        }
+    }
+
+    close(fd);
+
+    if (_mapped)
+        return true;
+#endif
+
+    FILE* f = fopen(fileName, "rb");
+    if (!f)
+        return false;
+
+    fseek(f, 0, SEEK_END);
+    long fileSize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (fileSize <= 0)
+    {
+        fclose(f);
+        return false;
+    }
+
+    _size = std::size_t(fileSize);
+    _data = new unsigned char[_size];
+    if (fread(_data, _size, 1, f) != 1)
+    {
+        fclose(f);
+        Close();
+        return false;
+    }
+
+    fclose(f);
+    return true;
+}
+
+void MappedDataFile::Close()
+{
+    if (!_data)
+        return;
+
+    if (_mapped)
+    {
+#if PLATFORM == PLATFORM_WINDOWS
+        UnmapViewOfFile(_data);
+#else
+        munmap(_data, _size);
+#endif
+    }
+    else
+        delete[] _data;
+
+    _data = NULL;
+    _size = 0;
+    _mapped = false;
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2008-2015 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPED_DATA_FILE_H
+#define MAPPED_DATA_FILE_H
+
+#include "Define.h"
+#include <cstddef>
+
+/// Whole client data file (dbc/db2) mapped copy-on-write into memory.
+/// Clean pages are shared through the page cache by every process mapping the same file,
+/// pages written to (hotfixes, script fixups) become private to this process.
+/// Falls back to reading the file into heap memory when it cannot be mapped.
+class MappedDataFile
+{
+    public:
+        MappedDataFile() : _data(NULL), _size(0), _mapped(false) { }
+        ~MappedDataFile() { Close(); }
+
+        bool Open(char const* fileName);
+        void Close();
+
+        unsigned char* GetData() const { return _data; }
+        std::size_t GetSize() const { return _size; }
+        bool IsMapped() const { return _mapped; }
+
+    private:
+        unsigned char* _data;
+        std::size_t _size;
+        bool _mapped;
+
+        MappedDataFile(MappedDataFile const& right) = delete;
+        MappedDataFile& operator=(MappedDataFile const& right) = delete;
+};
+
+#endif
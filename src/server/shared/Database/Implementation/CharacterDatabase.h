@@ -49,6 +49,8 @@ enum CharacterDatabaseStatements
     CHAR_SEL_GUID_BY_NAME,
     CHAR_SEL_CHECK_NAME,
     CHAR_SEL_CHECK_GUID,
+    CHAR_SEL_CHARACTER_INFO,
+    CHAR_SEL_CHARACTER_INFO_RECENT,
     CHAR_SEL_SUM_CHARS,
     CHAR_SEL_CHAR_CREATE_INFO,
     CHAR_INS_CHARACTER_BAN,
@@ -21,11 +21,117 @@
 #include "Common.h"
 #include "Log.h"
 #include <sstream>
+#include <boost/thread/tss.hpp>
+
+namespace
+{
+    // Released ByteBuffer storage kept per thread, grouped by power of two capacity
+    class ByteBufferStoragePool
+    {
+    public:
+        static uint32 const MinSizeClass = 6;               // 64 bytes
+        static uint32 const MaxSizeClass = 16;              // 64 kilobytes
+        static size_t const MaxFreeBuffers = 32;            // per size class
+
+        bool Acquire(std::vector<uint8>& storage, size_t reserve)
+        {
+            uint32 sizeClass = MinSizeClass;
+            while (sizeClass <= MaxSizeClass && (size_t(1) << sizeClass) < reserve)
+                ++sizeClass;
+
+            if (sizeClass > MaxSizeClass)
+            {
+                storage.reserve(reserve);
+                return false;
+            }
+
+            std::vector<std::vector<uint8>>& freeBuffers = _freeBuffers[sizeClass - MinSizeClass];
+            if (freeBuffers.empty())
+            {
+                storage.reserve(size_t(1) << sizeClass);
+                return false;
+            }
+
+            storage.swap(freeBuffers.back());
+            freeBuffers.pop_back();
+            return true;
+        }
+
+        bool Release(std::vector<uint8>& storage)
+        {
+            size_t capacity = storage.capacity();
+            if (capacity < (size_t(1) << MinSizeClass) || capacity >= (size_t(1) << (MaxSizeClass + 1)))
+                return false;
+
+            // largest class the capacity fully covers
+            uint32 sizeClass = MinSizeClass;
+            while ((size_t(1) << (sizeClass + 1)) <= capacity)
+                ++sizeClass;
+
+            std::vector<std::vector<uint8>>& freeBuffers = _freeBuffers[sizeClass - MinSizeClass];
+            if (freeBuffers.size() >= MaxFreeBuffers)
+                return false;
+
+            storage.clear();
+            freeBuffers.push_back(std::move(storage));
+            return true;
+        }
+
+    private:
+        std::vector<std::vector<uint8>> _freeBuffers[MaxSizeClass - MinSizeClass + 1];
+    };
+
+    ByteBufferPoolStatistics poolStatistics;
+
+    ByteBufferStoragePool* GetStoragePool()
+    {
+        // never destroyed, buffers with static storage duration may still be released during shutdown
+        static boost::thread_specific_ptr<ByteBufferStoragePool>* storagePool = new boost::thread_specific_ptr<ByteBufferStoragePool>();
+
+        ByteBufferStoragePool* pool = storagePool->get();
+        if (!pool)
+        {
+            pool = new ByteBufferStoragePool();
+            storagePool->reset(pool);
+        }
+
+        return pool;
+    }
+}
 
 ByteBuffer::ByteBuffer(MessageBuffer&& buffer) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0), _storage(buffer.Move())
 {
 }
 
+bool ByteBuffer::AcquireStorage(size_t reserve)
+{
+    if (!reserve)
+        return false;
+
+    if (GetStoragePool()->Acquire(_storage, reserve))
+    {
+        ++poolStatistics.Reused;
+        return true;
+    }
+
+    ++poolStatistics.Allocated;
+    return false;
+}
+
+void ByteBuffer::ReleaseStorage()
+{
+    if (!_storage.capacity())
+        return;
+
+    if (GetStoragePool()->Release(_storage))
+        ++poolStatistics.Released;
+}
+
+ByteBufferPoolStatistics const& ByteBuffer::GetPoolStatistics()
+{
+    return poolStatistics;
+}
+
 ByteBufferPositionException::ByteBufferPositionException(bool add, size_t pos, size_t size, size_t valueSize)
 {
     std::ostringstream ss;
@@ -24,6 +24,7 @@
 #include "ByteConverter.h"
 #include "Util.h"
 
+#include <atomic>
 #include <exception>
 #include <list>
 #include <map>
@@ -68,6 +69,14 @@ public:
     ~ByteBufferSourceException() throw() { }
 };
 
+// Counters of ByteBuffer storage reuse, shared by all threads
+struct ByteBufferPoolStatistics
+{
+    std::atomic<uint64> Allocated;
+    std::atomic<uint64> Reused;
+    std::atomic<uint64> Released;
+};
+
 class ByteBuffer
 {
     public:
@@ -77,12 +86,12 @@ class ByteBuffer
         // constructor
         ByteBuffer() : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
         {
-            _storage.reserve(DEFAULT_SIZE);
+            AcquireStorage(DEFAULT_SIZE);
         }
 
         ByteBuffer(size_t reserve) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
         {
-            _storage.reserve(reserve);
+            AcquireStorage(reserve);
         }
 
         ByteBuffer(ByteBuffer&& buf) : _rpos(buf._rpos), _wpos(buf._wpos),
@@ -130,7 +139,9 @@ class ByteBuffer
             return *this;
         }
 
-        virtual ~ByteBuffer() { }
+        virtual ~ByteBuffer() { ReleaseStorage(); }
+
+        static ByteBufferPoolStatistics const& GetPoolStatistics();
 
         void clear()
         {
@@ -196,18 +207,65 @@ class ByteBuffer
             return ((_curbitval >> (7-_bitpos)) & 1) != 0;
         }
 
+        // Same bit order as WriteBit, but moves up to 8 bits per step and appends all completed bytes at once
         template <typename T> void WriteBits(T value, int32 bits)
         {
-            for (int32 i = bits - 1; i >= 0; --i)
-                WriteBit((value >> i) & 1);
+            uint64 bitValue = uint64(value);
+            uint8 bytes[sizeof(uint64) + 1];
+            size_t byteCount = 0;
+
+            while (bits > 0)
+            {
+                // _bitpos holds the number of free bits left in _curbitval
+                int32 count = std::min<int32>(bits, _bitpos);
+                bits -= count;
+                _bitpos -= count;
+                _curbitval |= uint8(((bitValue >> bits) & ((1 << count) - 1)) << _bitpos);
+
+                if (_bitpos == 0)
+                {
+                    bytes[byteCount++] = _curbitval;
+                    _bitpos = 8;
+                    _curbitval = 0;
+                }
+            }
+
+            if (byteCount)
+            {
+                // append() flushes pending bits, keep the unfinished byte out of its way
+                size_t bitpos = _bitpos;
+                _bitpos = 8;
+                append(bytes, byteCount);
+                _bitpos = bitpos;
+            }
         }
 
+        // Same bit order as ReadBit, but extracts up to 8 bits per step
         uint32 ReadBits(int32 bits)
         {
             uint32 value = 0;
-            for (int32 i = bits - 1; i >= 0; --i)
-                if (ReadBit())
-                    value |= (1 << (i));
+            while (bits > 0)
+            {
+                int32 count;
+                uint8 chunk;
+                // _bitpos holds the index of the last bit read from _curbitval
+                if (_bitpos >= 7)
+                {
+                    _curbitval = read<uint8>();
+                    count = std::min<int32>(bits, 8);
+                    chunk = uint8(_curbitval >> (8 - count));
+                    _bitpos = uint8(count - 1);
+                }
+                else
+                {
+                    count = std::min<int32>(bits, 7 - _bitpos);
+                    chunk = uint8(_curbitval >> (7 - _bitpos - count));
+                    _bitpos += count;
+                }
+
+                bits -= count;
+                value = (value << count) | (chunk & ((1 << count) - 1));
+            }
 
             return value;
         }
@@ -252,14 +310,17 @@ class ByteBuffer
             if (pos + bitCount > size() * 8)
                 throw ByteBufferPositionException(false, (pos + bitCount) / 8, size(), (bitCount - 1) / 8 + 1);
 
-            for (uint32 i = 0; i < bitCount; ++i)
+            uint64 bitValue = uint64(value);
+            for (uint32 i = 0; i < bitCount;)
             {
                 size_t wp = (pos + i) / 8;
-                size_t bit = (pos + i) % 8;
-                if ((value >> (bitCount - i - 1)) & 1)
-                    _storage[wp] |= 1 << (7 - bit);
-                else
-                    _storage[wp] &= ~(1 << (7 - bit));
+                uint32 bit = (pos + i) % 8;
+                uint32 count = std::min(8 - bit, bitCount - i);
+                uint32 shift = 8 - bit - count;
+                uint8 mask = uint8(((1 << count) - 1) << shift);
+                uint8 chunk = uint8((bitValue >> (bitCount - i - count)) << shift);
+                _storage[wp] = (_storage[wp] & ~mask) | (chunk & mask);
+                i += count;
             }
         }
 
@@ -703,6 +764,13 @@ class ByteBuffer
         void hexlike() const;
 
     protected:
+        // Reserves at least reserve bytes, reusing storage released on this thread when possible.
+        // Returns false when the storage had to be allocated.
+        bool AcquireStorage(size_t reserve);
+
+        // Hands the storage over to the pool of the current thread, used by destructor
+        void ReleaseStorage();
+
         size_t _rpos, _wpos, _bitpos;
         uint8 _curbitval;
         std::vector<uint8> _storage;
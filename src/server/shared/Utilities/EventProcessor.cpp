@@ -17,11 +17,35 @@
  */
 
 #include "EventProcessor.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
+static uint32 CountTrailingZeros(uint64 value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    if (_BitScanForward(&index, uint32(value)))
+        return index;
+
+    _BitScanForward(&index, uint32(value >> 32));
+    return index + 32;
+#else
+    return __builtin_ctzll(value);
+#endif
+}
 
 EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+    m_wheelTime = 1;
+    m_sequence = 0;
+    m_count = 0;
+    m_readyPos = 0;
+    std::fill(m_occupied, m_occupied + WHEEL_LEVELS, 0);
 }
 
 EventProcessor::~EventProcessor()
@@ -34,13 +58,56 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
+    // events that were already due when they were added
+    ExecuteReady(p_time);
+
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (m_count && m_wheelTime <= m_time)
+    {
+        uint32 slot = uint32(m_wheelTime) & WHEEL_SLOT_MASK;
+        if (!slot)
+            Cascade();
+
+        if (m_occupied[0] & (uint64(1) << slot))
+        {
+            BasicEvent* Event = DetachSlot(slot);
+            while (Event)
+            {
+                BasicEvent* next = Event->m_next;
+                Event->m_next = NULL;
+                Event->m_prev = NULL;
+                m_ready.push_back(Event);
+                --m_count;
+                Event = next;
+            }
+
+            // events moved down from higher levels are mixed with ones added directly, all with the same execution time
+            std::sort(m_ready.begin(), m_ready.end(), ExecutesBefore);
+        }
+
+        ++m_wheelTime;
+        ExecuteReady(p_time);
+
+        // skip empty slots up to the next level 0 wrap around, where higher levels have to be moved down
+        if (m_wheelTime & WHEEL_SLOT_MASK)
+        {
+            uint64 pending = m_occupied[0] & (~uint64(0) << (m_wheelTime & WHEEL_SLOT_MASK));
+            uint64 next = pending ? (m_wheelTime & ~uint64(WHEEL_SLOT_MASK)) + CountTrailingZeros(pending) : (m_wheelTime | WHEEL_SLOT_MASK) + 1;
+            m_wheelTime = std::min(next, m_time + 1);
+        }
+    }
+
+    // nothing left in the wheel, nothing to move down either
+    if (!m_count)
+        m_wheelTime = m_time + 1;
+}
+
+void EventProcessor::ExecuteReady(uint32 p_time)
+{
+    while (m_readyPos < m_ready.size())
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        BasicEvent* Event = m_ready[m_readyPos++];
 
         if (!Event->to_Abort)
         {
@@ -56,6 +123,9 @@ void EventProcessor::Update(uint32 p_time)
             delete Event;
         }
     }
+
+    m_ready.clear();
+    m_readyPos = 0;
 }
 
 void EventProcessor::KillAllEvents(bool force)
@@ -63,33 +133,46 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
-    {
-        EventList::iterator i_old = i;
-        ++i;
+    // first, take all existing events out of the queue so Abort handlers adding events do not disturb the iteration
+    std::vector<BasicEvent*> events(m_ready.begin() + m_readyPos, m_ready.end());
+    m_ready.resize(m_readyPos);
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+    if (m_count)
+    {
+        for (uint32 slot = 0; slot < WHEEL_LEVELS * WHEEL_SLOTS; ++slot)
         {
-            delete i_old->second;
-
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+            BasicEvent* Event = DetachSlot(slot);
+            while (Event)
+            {
+                BasicEvent* next = Event->m_next;
+                Event->m_next = NULL;
+                Event->m_prev = NULL;
+                events.push_back(Event);
+                --m_count;
+                Event = next;
+            }
         }
     }
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    // abort them in execution order, events that cannot be deleted yet stay queued
+    std::sort(events.begin(), events.end(), ExecutesBefore);
+    for (BasicEvent* Event : events)
+    {
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+        if (force || Event->IsDeletable())
+            delete Event;
+        else
+            Schedule(Event);
+    }
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
 {
     if (set_addtime) Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+    Event->m_sequence = m_sequence++;
+    Schedule(Event);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -97,3 +180,91 @@ uint64 EventProcessor::CalculateTime(uint64 t_offset) const
     return(m_time + t_offset);
 }
 
+bool EventProcessor::ExecutesBefore(BasicEvent const* left, BasicEvent const* right)
+{
+    if (left->m_execTime != right->m_execTime)
+        return left->m_execTime < right->m_execTime;
+
+    return left->m_sequence < right->m_sequence;
+}
+
+void EventProcessor::Schedule(BasicEvent* Event)
+{
+    if (Event->m_execTime >= m_wheelTime)
+    {
+        InsertIntoWheel(Event);
+        ++m_count;
+        return;
+    }
+
+    // the tick was processed already, execute with the events of the running (or next) Update
+    m_ready.insert(std::upper_bound(m_ready.begin() + m_readyPos, m_ready.end(), Event, ExecutesBefore), Event);
+}
+
+void EventProcessor::InsertIntoWheel(BasicEvent* Event)
+{
+    if (m_wheel.empty())
+        m_wheel.resize(WHEEL_LEVELS * WHEEL_SLOTS, NULL);
+
+    uint64 expires = Event->m_execTime;
+    uint64 delta = expires - m_wheelTime;
+    uint32 level = 0;
+    while (level < WHEEL_LEVELS - 1 && delta >> ((level + 1) * WHEEL_SLOT_BITS))
+        ++level;
+
+    // beyond the wheel range, wait in the farthest slot and get placed again from there
+    if (delta >> (WHEEL_LEVELS * WHEEL_SLOT_BITS))
+        expires = m_wheelTime + (uint64(1) << (WHEEL_LEVELS * WHEEL_SLOT_BITS)) - 1;
+
+    uint32 slot = uint32(expires >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+    Event->m_wheelSlot = level * WHEEL_SLOTS + slot;
+
+    // append to the circular list of the slot, the head's m_prev is the tail
+    BasicEvent*& head = m_wheel[Event->m_wheelSlot];
+    if (!head)
+    {
+        head = Event;
+        Event->m_next = Event;
+        Event->m_prev = Event;
+        m_occupied[level] |= uint64(1) << slot;
+    }
+    else
+    {
+        Event->m_next = head;
+        Event->m_prev = head->m_prev;
+        head->m_prev->m_next = Event;
+        head->m_prev = Event;
+    }
+}
+
+BasicEvent* EventProcessor::DetachSlot(uint32 slot)
+{
+    BasicEvent* head = m_wheel[slot];
+    if (!head)
+        return NULL;
+
+    // break the circle, the caller walks m_next until NULL
+    head->m_prev->m_next = NULL;
+    m_wheel[slot] = NULL;
+    m_occupied[slot / WHEEL_SLOTS] &= ~(uint64(1) << (slot & WHEEL_SLOT_MASK));
+    return head;
+}
+
+void EventProcessor::Cascade()
+{
+    // level 0 wrapped around, move the events of the now current slot of each level one level down (further if they are close)
+    for (uint32 level = 1; level < WHEEL_LEVELS; ++level)
+    {
+        uint32 slot = uint32(m_wheelTime >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+        BasicEvent* Event = DetachSlot(level * WHEEL_SLOTS + slot);
+        while (Event)
+        {
+            BasicEvent* next = Event->m_next;
+            InsertIntoWheel(Event);
+            Event = next;
+        }
+
+        if (slot)
+            break;
+    }
+}
@@ -21,18 +21,24 @@
 
 #include "Define.h"
 
-#include <map>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
 class BasicEvent
 {
+    friend class EventProcessor;
+
     public:
         BasicEvent()
         {
             to_Abort = false;
             m_addTime = 0;
             m_execTime = 0;
+            m_sequence = 0;
+            m_next = NULL;
+            m_prev = NULL;
+            m_wheelSlot = 0;
         }
         virtual ~BasicEvent() { }                           // override destructor to perform some actions on event removal
 
@@ -51,10 +57,18 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        uint64 m_sequence;                                  // insertion order, events with equal m_execTime execute in the order they were added
+        BasicEvent* m_next;                                 // links in the timer wheel slot, m_prev is NULL while the event is not in the wheel
+        BasicEvent* m_prev;
+        uint32 m_wheelSlot;
+};
 
+// Events are kept in a hierarchical timer wheel: WHEEL_LEVELS levels of WHEEL_SLOTS slots, level 0 slots are 1 ms wide,
+// every further level WHEEL_SLOTS times wider. Events are linked into their slot directly (no allocation) so adding
+// an event is O(1); events of a higher level slot are moved down a level when level 0 wraps around.
+// Events further away than the wheel covers wait in the last level and are moved again when their slot comes up.
 class EventProcessor
 {
     public:
@@ -67,7 +81,31 @@ class EventProcessor
         uint64 CalculateTime(uint64 t_offset) const;
     protected:
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+    private:
+        enum
+        {
+            WHEEL_SLOT_BITS = 6,                            // m_occupied has a bit per slot
+            WHEEL_SLOTS     = 1 << WHEEL_SLOT_BITS,
+            WHEEL_SLOT_MASK = WHEEL_SLOTS - 1,
+            WHEEL_LEVELS    = 4
+        };
+
+        static bool ExecutesBefore(BasicEvent const* left, BasicEvent const* right);
+
+        void Schedule(BasicEvent* Event);
+        void InsertIntoWheel(BasicEvent* Event);
+        BasicEvent* DetachSlot(uint32 slot);
+        void Cascade();
+        void ExecuteReady(uint32 p_time);
+
+        uint64 m_wheelTime;                                 // next tick of the wheel to process, all earlier slots are empty
+        uint64 m_sequence;
+        uint32 m_count;                                     // events in the wheel
+        std::vector<BasicEvent*> m_wheel;                   // WHEEL_LEVELS * WHEEL_SLOTS circular lists, allocated with the first event
+        uint64 m_occupied[WHEEL_LEVELS];                    // bit per non empty slot
+        std::vector<BasicEvent*> m_ready;                   // events of the tick being processed, ordered by execution time and sequence
+        std::size_t m_readyPos;
 };
 #endif
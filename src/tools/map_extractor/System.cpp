@@ -18,10 +18,17 @@
 
 #define _CRT_SECURE_NO_DEPRECATE
 
+#include <algorithm>
 #include <cstdio>
+#include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <vector>
 #include <cstdlib>
 #include <cstring>
 
@@ -127,6 +134,11 @@ float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - l
 
 uint32 CONF_Locale = 0;
 
+// Number of threads converting adt files, 0 = one per core
+uint32 CONF_threads = 0;
+
+#define MAX_THREADS 64
+
 #define LOCALES_COUNT 17
 
 char const* Locales[LOCALES_COUNT] =
@@ -178,7 +190,8 @@ void Usage(char const* prg)
         "-o set output path (max %d characters)\n"\
         "-e extract only MAP(1)/DBC(2) - standard: both(3)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
-        "Example: %s -f 0 -i \"c:\\games\\game\"\n", prg, MAX_PATH_LENGTH - 1, MAX_PATH_LENGTH - 1, prg);
+        "-t number of threads converting map files (1 - %d) - standard: one per core\n"\
+        "Example: %s -f 0 -i \"c:\\games\\game\"\n", prg, MAX_PATH_LENGTH - 1, MAX_PATH_LENGTH - 1, MAX_THREADS, prg);
     exit(1);
 }
 
@@ -192,6 +205,7 @@ void HandleArgs(int argc, char* arg[])
         // f - use float to int conversion
         // h - limit minimum height
         // b - target client build
+        // t - number of map extraction threads
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -242,6 +256,19 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if (c + 1 < argc)                            // all ok
+                {
+                    char* end;
+                    long threads = strtol(arg[c++ + 1], &end, 10);
+                    if (*end != '\0' || threads < 1)
+                        Usage(arg[0]);
+
+                    CONF_threads = uint32(std::min<long>(threads, MAX_THREADS));
+                }
+                else
+                    Usage(arg[0]);
+                break;
             case 'h':
                 Usage(arg[0]);
                 break;
@@ -477,21 +504,36 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
+// Converts adt files to .map files, every extraction thread has its own converter
+class ADTConverter
+{
+public:
+    ADTConverter() : BytesRead(0), BytesWritten(0) { }
+
+    bool ConvertADT(char *filename, char *filename2, int cell_y, int cell_x, uint32 build);
+
+    uint64 BytesRead;
+    uint64 BytesWritten;
+
+private:
+    ChunkedFile adt;                                        // keeps the read buffer between files
+
+    // Temporary grid data store
+    uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+    float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+
+    uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+    uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+    bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+    float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+    uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
+};
 
 bool TransformToHighRes(uint16 holes, uint8 hiResHoles[8])
 {
@@ -508,13 +550,13 @@ bool TransformToHighRes(uint16 holes, uint8 hiResHoles[8])
     return *((uint64*)hiResHoles) != 0;
 }
 
-bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/, uint32 build)
+bool ADTConverter::ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/, uint32 build)
 {
-    ChunkedFile adt;
-
     if (!adt.loadFile(CascStorage, filename))
         return false;
 
+    BytesRead += adt.GetDataSize();
+
     // Prepare map header
     map_fileheader map;
     map.mapMagic = *(uint32 const*)MAP_MAGIC;
@@ -1030,6 +1072,7 @@ bool ConvertADT(char *filename, char *filename2, int /*cell_y*/, int /*cell_x*/,
     if (hasHoles)
         fwrite(holes, map.holesSize, 1, output);
 
+    BytesWritten += ftell(output);
     fclose(output);
 
     return true;
@@ -1052,10 +1095,126 @@ void ExtractWmos(ChunkedFile& file, std::set<std::string>& wmoList)
     }
 }
 
+double GetSecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double ToMegabytes(uint64 bytes)
+{
+    return bytes / (1024.0 * 1024.0);
+}
+
+struct ADTTask
+{
+    uint32 MapIndex;
+    uint32 X;
+    uint32 Y;
+};
+
+// Fixed number of threads converting adt files. The queue is bounded, scanning wdt files
+// only runs a little ahead of the conversion.
+class ADTWorkerPool
+{
+public:
+    ADTWorkerPool(uint32 threads, uint32 build) : AdtCount(0), BytesRead(0), BytesWritten(0), _build(build), _finished(false)
+    {
+        for (uint32 i = 0; i < threads; ++i)
+            _workers.push_back(std::thread(&ADTWorkerPool::WorkerThread, this));
+    }
+
+    void Enqueue(ADTTask const& task)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        while (_queue.size() >= _workers.size() * 4)
+            _queueNotFull.wait(lock);
+
+        _queue.push_back(task);
+        _queueNotEmpty.notify_one();
+    }
+
+    // Waits until all queued files are converted, the members below are valid afterwards
+    void Finish()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _finished = true;
+        }
+
+        _queueNotEmpty.notify_all();
+
+        for (std::thread& worker : _workers)
+            worker.join();
+
+        _workers.clear();
+    }
+
+    std::set<std::string> WmoList;
+    uint32 AdtCount;
+    uint64 BytesRead;
+    uint64 BytesWritten;
+
+private:
+    bool Pop(ADTTask& task)
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        while (_queue.empty() && !_finished)
+            _queueNotEmpty.wait(lock);
+
+        if (_queue.empty())
+            return false;
+
+        task = _queue.front();
+        _queue.pop_front();
+        _queueNotFull.notify_one();
+        return true;
+    }
+
+    void WorkerThread()
+    {
+        char storagePath[1024];
+        char outputFileName[1024];
+
+        // converter and obj0 file keep their buffers for all files of this thread
+        std::unique_ptr<ADTConverter> converter(new ADTConverter());
+        ChunkedFile adtObj;
+        std::set<std::string> wmoList;
+        uint32 adtCount = 0;
+
+        ADTTask task;
+        while (Pop(task))
+        {
+            map_id const& map = map_ids[task.MapIndex];
+            sprintf(storagePath, "World\\Maps\\%s\\%s_%u_%u.adt", map.name, map.name, task.X, task.Y);
+            sprintf(outputFileName, "%s/maps/%04u_%02u_%02u.map", output_path, map.id, task.Y, task.X);
+            if (converter->ConvertADT(storagePath, outputFileName, task.Y, task.X, _build))
+                ++adtCount;
+
+            sprintf(storagePath, "World\\Maps\\%s\\%s_%u_%u_obj0.adt", map.name, map.name, task.X, task.Y);
+            if (adtObj.loadFile(CascStorage, storagePath, false))
+                ExtractWmos(adtObj, wmoList);
+        }
+
+        std::lock_guard<std::mutex> lock(_lock);
+        WmoList.insert(wmoList.begin(), wmoList.end());
+        AdtCount += adtCount;
+        BytesRead += converter->BytesRead;
+        BytesWritten += converter->BytesWritten;
+    }
+
+    uint32 _build;
+    std::vector<std::thread> _workers;
+
+    std::mutex _lock;
+    std::condition_variable _queueNotEmpty;
+    std::condition_variable _queueNotFull;
+    std::deque<ADTTask> _queue;
+    bool _finished;
+};
+
 void ExtractMaps(uint32 build)
 {
     char storagePath[1024];
-    char output_filename[1024];
 
     printf("Extracting maps...\n");
 
@@ -1068,9 +1227,15 @@ void ExtractMaps(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
+    uint32 threads = CONF_threads ? CONF_threads : std::thread::hardware_concurrency();
+    if (!threads)
+        threads = 1;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ADTWorkerPool workers(threads, build);
     std::set<std::string> wmoList;
 
-    printf("Convert map files\n");
+    printf("Convert map files using %u threads\n", threads);
     for (uint32 z = 0; z < map_count; ++z)
     {
         printf("Extract %s (%d/%u)                  \n", map_ids[z].name, z+1, map_count);
@@ -1090,14 +1255,11 @@ void ExtractMaps(uint32 build)
                 if (!(chunk->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
                     continue;
 
-                sprintf(storagePath, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
-                sprintf(output_filename, "%s/maps/%04u_%02u_%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(storagePath, output_filename, y, x, build);
-
-                sprintf(storagePath, "World\\Maps\\%s\\%s_%u_%u_obj0.adt", map_ids[z].name, map_ids[z].name, x, y);
-                ChunkedFile adtObj;
-                if (adtObj.loadFile(CascStorage, storagePath, false))
-                    ExtractWmos(adtObj, wmoList);
+                ADTTask task;
+                task.MapIndex = z;
+                task.X = x;
+                task.Y = y;
+                workers.Enqueue(task);
             }
 
             // draw progress bar
@@ -1105,6 +1267,9 @@ void ExtractMaps(uint32 build)
         }
     }
 
+    workers.Finish();
+    wmoList.insert(workers.WmoList.begin(), workers.WmoList.end());
+
     if (!wmoList.empty())
     {
         if (FILE* wmoListFile = fopen("wmo_list.txt", "w"))
@@ -1116,7 +1281,13 @@ void ExtractMaps(uint32 build)
         }
     }
 
+    double seconds = GetSecondsSince(start);
     printf("\n");
+    printf("Converted %u map files in %.2f s (%.1f files/s)\n", workers.AdtCount, seconds, seconds > 0.0 ? workers.AdtCount / seconds : 0.0);
+    printf("Read %.1f MB from CASC (%.1f MB/s), wrote %.1f MB (%.1f MB/s)\n",
+        ToMegabytes(workers.BytesRead), seconds > 0.0 ? ToMegabytes(workers.BytesRead) / seconds : 0.0,
+        ToMegabytes(workers.BytesWritten), seconds > 0.0 ? ToMegabytes(workers.BytesWritten) / seconds : 0.0);
+
     delete[] areas;
     delete[] map_ids;
 }
@@ -1156,8 +1327,10 @@ void ExtractDBFilesClient(int l)
     outputPath += "/";
     CreateDir(outputPath);
 
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     uint32 index = 0;
     uint32 count = 0;
+    uint64 bytes = 0;
     char const* fileName = DBFilesClientList[index];
     HANDLE dbcFile;
     while (fileName)
@@ -1169,8 +1342,13 @@ void ExtractDBFilesClient(int l)
             filename = outputPath + filename.substr(filename.rfind('\\') + 1);
 
             if (!FileExists(filename.c_str()))
+            {
                 if (ExtractFile(dbcFile, filename.c_str()))
+                {
                     ++count;
+                    bytes += CascGetFileSize(dbcFile, NULL);
+                }
+            }
 
             CascCloseFile(dbcFile);
         }
@@ -1180,7 +1358,8 @@ void ExtractDBFilesClient(int l)
         fileName = DBFilesClientList[++index];
     }
 
-    printf("Extracted %u files\n\n", count);
+    double seconds = GetSecondsSince(start);
+    printf("Extracted %u files (%.1f MB) in %.2f s (%.1f MB/s)\n\n", count, ToMegabytes(bytes), seconds, seconds > 0.0 ? ToMegabytes(bytes) / seconds : 0.0);
 }
 
 bool OpenCascStorage()
@@ -20,6 +20,9 @@
 
 #include "loadlib.h"
 #include <cstdio>
+#include <mutex>
+
+static std::mutex CascReadLock;
 
 u_map_fcc MverMagic = { { 'R','E','V','M' } };
 
@@ -27,36 +30,49 @@ ChunkedFile::ChunkedFile()
 {
     data = 0;
     data_size = 0;
+    data_capacity = 0;
 }
 
 ChunkedFile::~ChunkedFile()
 {
     free();
+    delete[] data;
 }
 
 bool ChunkedFile::loadFile(HANDLE mpq, char* filename, bool log)
 {
     free();
-    HANDLE file;
-    if (!CascOpenFile(mpq, filename, CASC_LOCALE_ALL, 0, &file))
+
     {
-        if (log)
-            printf("No such file %s\n", filename);
-        return false;
+        std::lock_guard<std::mutex> lock(CascReadLock);
+
+        HANDLE file;
+        if (!CascOpenFile(mpq, filename, CASC_LOCALE_ALL, 0, &file))
+        {
+            if (log)
+                printf("No such file %s\n", filename);
+            return false;
+        }
+
+        uint32 size = CascGetFileSize(file, NULL);
+        if (size > data_capacity)
+        {
+            delete[] data;
+            data = new uint8[size];
+            data_capacity = size;
+        }
+
+        data_size = size;
+        CascReadFile(file, data, data_size, NULL/*bytesRead*/);
+        CascCloseFile(file);
     }
 
-    data_size = CascGetFileSize(file, NULL);
-    data = new uint8[data_size];
-    CascReadFile(file, data, data_size, NULL/*bytesRead*/);
+    // parsing does not touch the storage, let other threads read meanwhile
     parseChunks();
     if (prepareLoadedData())
-    {
-        CascCloseFile(file);
         return true;
-    }
 
     printf("Error loading %s\n", filename);
-    CascCloseFile(file);
     free();
 
     return false;
@@ -84,8 +100,6 @@ void ChunkedFile::free()
 
     chunks.clear();
 
-    delete[] data;
-    data = 0;
     data_size = 0;
 }
 
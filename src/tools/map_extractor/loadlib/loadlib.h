@@ -83,11 +83,14 @@ public:
     FileChunk* GetSubChunk(std::string const& name);
 };
 
+// CascLib storage handles are not thread safe, all ChunkedFile reads from CASC are serialized.
+// The read buffer is kept between loadFile calls, reuse one ChunkedFile for many files.
 class ChunkedFile
 {
 public:
     uint8  *data;
     uint32  data_size;
+    uint32  data_capacity;
 
     uint8 *GetData()     { return data; }
     uint32 GetDataSize() { return data_size; }
@@ -96,7 +99,7 @@ public:
     virtual ~ChunkedFile();
     bool prepareLoadedData();
     bool loadFile(HANDLE mpq, char *filename, bool log = true);
-    void free();
+    void free();                                            // drops the loaded file, keeps the buffer
 
     void parseChunks();
     std::multimap<std::string, FileChunk*> chunks;
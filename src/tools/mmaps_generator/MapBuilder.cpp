@@ -20,6 +20,7 @@
 #include "PathCommon.h"
 #include "MapBuilder.h"
 #include "StringFormat.h"
+#include "Timer.h"
 
 #include "MapTree.h"
 #include "ModelInstance.h"
@@ -57,7 +58,8 @@ namespace MMAP
         m_maxWalkableAngle   (maxWalkableAngle),
         m_bigBaseUnit        (bigBaseUnit),
         m_rcContext          (NULL),
-        _cancelationToken    (false)
+        _cancelationToken    (false),
+        _pendingTiles        (0)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
@@ -162,24 +164,27 @@ namespace MMAP
     {
         while (1)
         {
-            uint32 mapId;
+            TileBuildTask task;
 
-            _queue.WaitAndPop(mapId);
+            _queue.WaitAndPop(task);
 
             if (_cancelationToken)
                 return;
 
-            buildMap(mapId);
+            buildTileTask(task);
         }
     }
 
     void MapBuilder::buildAllMaps(int threads)
     {
+        uint32 start = getMSTime();
+
         for (int i = 0; i < threads; ++i)
         {
             _workerThreads.push_back(std::thread(&MapBuilder::WorkerThread, this));
         }
 
+        // big maps first, their tiles keep all threads busy while the small ones are prepared
         m_tiles.sort([](MapTiles a, MapTiles b)
         {
             return a.m_tiles->size() > b.m_tiles->size();
@@ -188,18 +193,31 @@ namespace MMAP
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapId = it->m_mapId;
-            if (!shouldSkipMap(mapId))
+            if (shouldSkipMap(mapId))
+                continue;
+
+            std::vector<TileBuildTask> tasks = prepareMap(mapId);
+            if (threads > 0)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_pendingTilesLock);
+                    _pendingTiles += tasks.size();
+                }
+
+                for (TileBuildTask const& task : tasks)
+                    _queue.Push(task);
+            }
+            else
             {
-                if (threads > 0)
-                    _queue.Push(mapId);
-                else
-                    buildMap(mapId);
+                for (TileBuildTask const& task : tasks)
+                    buildTileTask(task);
             }
         }
 
-        while (!_queue.Empty())
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            std::unique_lock<std::mutex> lock(_pendingTilesLock);
+            while (_pendingTiles)
+                _pendingTilesCondition.wait(lock);
         }
 
         _cancelationToken = true;
@@ -210,6 +228,137 @@ namespace MMAP
         {
             thread.join();
         }
+
+        printTileStatistics(GetMSTimeDiffToNow(start));
+    }
+
+    /**************************************************************************/
+    std::vector<TileBuildTask> MapBuilder::prepareMap(uint32 mapID)
+    {
+        std::vector<TileBuildTask> tasks;
+        std::set<uint32>* tiles = getTileList(mapID);
+
+        // make sure we process maps which don't have tiles
+        if (!tiles->size())
+        {
+            // convert coord bounds to grid bounds
+            uint32 minX, minY, maxX, maxY;
+            getGridBounds(mapID, minX, minY, maxX, maxY);
+
+            // add all tiles within bounds to tile list.
+            for (uint32 i = minX; i <= maxX; ++i)
+                for (uint32 j = minY; j <= maxY; ++j)
+                    tiles->insert(StaticMapTree::packTileID(i, j));
+        }
+
+        if (!tiles->empty())
+        {
+            // build navMesh, tiles only need its params
+            dtNavMesh* navMesh = NULL;
+            buildNavMesh(mapID, navMesh);
+            if (!navMesh)
+            {
+                printf("[Map %04i] Failed creating navmesh!\n", mapID);
+                m_terrainBuilder->releaseVMapModels(mapID);
+                return tasks;
+            }
+
+            MapBuildState& state = _mapStates[mapID];
+            state.m_mapId = mapID;
+            state.m_navMeshParams = *navMesh->getParams();
+            dtFreeNavMesh(navMesh);
+
+            printf("[Map %04i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
+            for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
+            {
+                uint32 tileX, tileY;
+
+                // unpack tile coords
+                StaticMapTree::unpackTileID((*it), tileX, tileY);
+
+                if (shouldSkipTile(mapID, tileX, tileY))
+                    continue;
+
+                tasks.push_back(TileBuildTask(&state, tileX, tileY));
+            }
+
+            state.m_pendingTiles = tasks.size();
+        }
+
+        if (tasks.empty())
+        {
+            m_terrainBuilder->releaseVMapModels(mapID);
+            printf("[Map %04u] Complete!\n", mapID);
+        }
+
+        return tasks;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::buildTileTask(TileBuildTask const& task)
+    {
+        MapBuildState& state = *task.m_map;
+        uint32 start = getMSTime();
+
+        // a private navMesh per tile, tiles are only added to it to validate them
+        dtNavMesh* navMesh = dtAllocNavMesh();
+        if (navMesh->init(&state.m_navMeshParams))
+            buildTile(state.m_mapId, task.m_tileX, task.m_tileY, navMesh);
+        else
+            printf("[Map %04u] [%02u,%02u]: Failed creating navmesh!\n", state.m_mapId, task.m_tileX, task.m_tileY);
+
+        dtFreeNavMesh(navMesh);
+
+        TileBuildTime time;
+        time.m_mapId = state.m_mapId;
+        time.m_tileX = task.m_tileX;
+        time.m_tileY = task.m_tileY;
+        time.m_time = GetMSTimeDiffToNow(start);
+
+        {
+            std::lock_guard<std::mutex> lock(_tileTimesLock);
+            _tileTimes.push_back(time);
+        }
+
+        if (--state.m_pendingTiles == 0)
+        {
+            m_terrainBuilder->releaseVMapModels(state.m_mapId);
+            printf("[Map %04u] Complete!\n", state.m_mapId);
+        }
+
+        if (!_workerThreads.empty())
+        {
+            std::lock_guard<std::mutex> lock(_pendingTilesLock);
+            if (--_pendingTiles == 0)
+                _pendingTilesCondition.notify_all();
+        }
+    }
+
+    /**************************************************************************/
+    void MapBuilder::printTileStatistics(uint32 wallTime)
+    {
+        std::lock_guard<std::mutex> lock(_tileTimesLock);
+        if (_tileTimes.empty())
+            return;
+
+        std::sort(_tileTimes.begin(), _tileTimes.end(), [](TileBuildTime const& left, TileBuildTime const& right)
+        {
+            return left.m_time > right.m_time;
+        });
+
+        uint64 totalTime = 0;
+        for (TileBuildTime const& time : _tileTimes)
+            totalTime += time.m_time;
+
+        uint32 count = _tileTimes.size();
+        printf("\nBuilt %u tiles in %u ms, %llu ms spent building tiles (%.2f tiles/s).\n", count, wallTime,
+            (unsigned long long)totalTime, wallTime ? count * 1000.0f / wallTime : 0.0f);
+        printf("Tile build time: min %u ms, median %u ms, average %u ms, max %u ms\n", _tileTimes.back().m_time,
+            _tileTimes[count / 2].m_time, uint32(totalTime / count), _tileTimes.front().m_time);
+
+        printf("Slowest tiles:\n");
+        for (uint32 i = 0; i < count && i < 10; ++i)
+            printf("    [Map %04u] [%02u,%02u]: %u ms\n", _tileTimes[i].m_mapId, _tileTimes[i].m_tileX, _tileTimes[i].m_tileY, _tileTimes[i].m_time);
     }
 
     /**************************************************************************/
@@ -353,60 +502,19 @@ namespace MMAP
 
         buildTile(mapID, tileX, tileY, navMesh);
         dtFreeNavMesh(navMesh);
+        m_terrainBuilder->releaseVMapModels(mapID);
     }
 
     /**************************************************************************/
     void MapBuilder::buildMap(uint32 mapID)
     {
-#ifndef __APPLE__
-        //printf("[Thread %u] Building map %03u:\n", uint32(ACE_Thread::self()), mapID);
-#endif
-
-        std::set<uint32>* tiles = getTileList(mapID);
-
-        // make sure we process maps which don't have tiles
-        if (!tiles->size())
-        {
-            // convert coord bounds to grid bounds
-            uint32 minX, minY, maxX, maxY;
-            getGridBounds(mapID, minX, minY, maxX, maxY);
+        uint32 start = getMSTime();
 
-            // add all tiles within bounds to tile list.
-            for (uint32 i = minX; i <= maxX; ++i)
-                for (uint32 j = minY; j <= maxY; ++j)
-                    tiles->insert(StaticMapTree::packTileID(i, j));
-        }
-
-        if (!tiles->empty())
-        {
-            // build navMesh
-            dtNavMesh* navMesh = NULL;
-            buildNavMesh(mapID, navMesh);
-            if (!navMesh)
-            {
-                printf("[Map %04i] Failed creating navmesh!\n", mapID);
-                return;
-            }
-
-            // now start building mmtiles for each tile
-            printf("[Map %04i] We have %u tiles.                          \n", mapID, (unsigned int)tiles->size());
-            for (std::set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
-            {
-                uint32 tileX, tileY;
-
-                // unpack tile coords
-                StaticMapTree::unpackTileID((*it), tileX, tileY);
-
-                if (shouldSkipTile(mapID, tileX, tileY))
-                    continue;
-
-                buildTile(mapID, tileX, tileY, navMesh);
-            }
-
-            dtFreeNavMesh(navMesh);
-        }
+        std::vector<TileBuildTask> tasks = prepareMap(mapID);
+        for (TileBuildTask const& task : tasks)
+            buildTileTask(task);
 
-        printf("[Map %04u] Complete!\n", mapID);
+        printTileStatistics(GetMSTimeDiffToNow(start));
     }
 
     /**************************************************************************/
@@ -24,6 +24,8 @@
 #include <map>
 #include <list>
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #include "TerrainBuilder.h"
@@ -55,6 +57,33 @@ namespace MMAP
 
     typedef std::list<MapTiles> TileList;
 
+    struct MapBuildState
+    {
+        MapBuildState() : m_mapId(0), m_pendingTiles(0) { memset(&m_navMeshParams, 0, sizeof(m_navMeshParams)); }
+
+        uint32 m_mapId;
+        dtNavMeshParams m_navMeshParams;        // every tile builds into its own navMesh created from these
+        std::atomic<uint32> m_pendingTiles;
+    };
+
+    struct TileBuildTask
+    {
+        TileBuildTask() : m_map(NULL), m_tileX(0), m_tileY(0) {}
+        TileBuildTask(MapBuildState* map, uint32 tileX, uint32 tileY) : m_map(map), m_tileX(tileX), m_tileY(tileY) {}
+
+        MapBuildState* m_map;
+        uint32 m_tileX;
+        uint32 m_tileY;
+    };
+
+    struct TileBuildTime
+    {
+        uint32 m_mapId;
+        uint32 m_tileX;
+        uint32 m_tileY;
+        uint32 m_time;                          // ms
+    };
+
     struct Tile
     {
         Tile() : chf(NULL), solid(NULL), cset(NULL), pmesh(NULL), dmesh(NULL) {}
@@ -95,6 +124,7 @@ namespace MMAP
             void buildSingleTile(uint32 mapID, uint32 tileX, uint32 tileY);
 
             // builds list of maps, then builds all of mmap tiles (based on the skip settings)
+            // tiles of all maps are shared between the worker threads
             void buildAllMaps(int threads);
 
             void WorkerThread();
@@ -106,6 +136,11 @@ namespace MMAP
 
             void buildNavMesh(uint32 mapID, dtNavMesh* &navMesh);
 
+            // writes the map's navMesh and returns the tiles to build, empty if there is nothing to do
+            std::vector<TileBuildTask> prepareMap(uint32 mapID);
+            void buildTileTask(TileBuildTask const& task);
+            void printTileStatistics(uint32 wallTime);
+
             void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
 
             // move map building
@@ -143,8 +178,18 @@ namespace MMAP
             rcContext* m_rcContext;
 
             std::vector<std::thread> _workerThreads;
-            ProducerConsumerQueue<uint32> _queue;
+            ProducerConsumerQueue<TileBuildTask> _queue;
             std::atomic<bool> _cancelationToken;
+
+            // nodes are never moved, queued tasks point into them
+            std::map<uint32, MapBuildState> _mapStates;
+
+            std::mutex _pendingTilesLock;
+            std::condition_variable _pendingTilesCondition;
+            uint32 _pendingTiles;
+
+            std::mutex _tileTimesLock;
+            std::vector<TileBuildTime> _tileTimes;
     };
 }
 
@@ -82,8 +82,15 @@ namespace MMAP
 
     char const* MAP_VERSION_MAGIC = "v1.5";
 
-    TerrainBuilder::TerrainBuilder(bool skipLiquid) : m_skipLiquid (skipLiquid){ }
-    TerrainBuilder::~TerrainBuilder() { }
+    TerrainBuilder::TerrainBuilder(bool skipLiquid) : m_skipLiquid (skipLiquid), m_vmapManager(new VMapManager2()) { }
+    TerrainBuilder::~TerrainBuilder()
+    {
+        for (auto itr = m_cachedModels.begin(); itr != m_cachedModels.end(); ++itr)
+            for (std::string const& model : itr->second)
+                m_vmapManager->releaseModelInstance(model);
+
+        delete m_vmapManager;
+    }
 
     /**************************************************************************/
     void TerrainBuilder::getLoopVars(Spot portion, int &loopStart, int &loopEnd, int &loopInc)
@@ -626,28 +633,34 @@ namespace MMAP
     /**************************************************************************/
     bool TerrainBuilder::loadVMap(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData)
     {
-        IVMapManager* vmapManager = new VMapManager2();
-        int result = vmapManager->loadMap("vmaps", mapID, tileX, tileY);
+        // every call gets its own tree so only this tile's spawns are loaded,
+        // the model files themselves come from the shared manager
+        StaticMapTree instanceTree(mapID, "vmaps");
+        bool result = instanceTree.InitMap(VMapManager2::getMapFileName(mapID), m_vmapManager) &&
+            instanceTree.LoadMapTile(tileX, tileY, m_vmapManager);
         bool retval = false;
 
         do
         {
-            if (result == VMAP_LOAD_RESULT_ERROR)
-                break;
-
-            InstanceTreeMap instanceTrees;
-            ((VMapManager2*)vmapManager)->getInstanceMapTree(instanceTrees);
-
-            if (!instanceTrees[mapID])
+            if (!result)
                 break;
 
             ModelInstance* models = NULL;
             uint32 count = 0;
-            instanceTrees[mapID]->getModelInstances(models, count);
+            instanceTree.getModelInstances(models, count);
 
             if (!models)
                 break;
 
+            // keep an extra reference until the whole map is built, neighbouring tiles mostly use the same models
+            {
+                std::lock_guard<std::mutex> lock(m_cachedModelsLock);
+                std::set<std::string>& cachedModels = m_cachedModels[mapID];
+                for (uint32 i = 0; i < count; ++i)
+                    if (models[i].getWorldModel() && cachedModels.insert(models[i].name).second)
+                        m_vmapManager->acquireModelInstance("vmaps/", models[i].name);
+            }
+
             for (uint32 i = 0; i < count; ++i)
             {
                 ModelInstance instance = models[i];
@@ -773,12 +786,29 @@ namespace MMAP
         }
         while (false);
 
-        vmapManager->unloadMap(mapID, tileX, tileY);
-        delete vmapManager;
+        instanceTree.UnloadMap(m_vmapManager);
 
         return retval;
     }
 
+    /**************************************************************************/
+    void TerrainBuilder::releaseVMapModels(uint32 mapID)
+    {
+        std::set<std::string> cachedModels;
+        {
+            std::lock_guard<std::mutex> lock(m_cachedModelsLock);
+            auto itr = m_cachedModels.find(mapID);
+            if (itr == m_cachedModels.end())
+                return;
+
+            cachedModels.swap(itr->second);
+            m_cachedModels.erase(itr);
+        }
+
+        for (std::string const& model : cachedModels)
+            m_vmapManager->releaseModelInstance(model);
+    }
+
     /**************************************************************************/
     void TerrainBuilder::transform(std::vector<G3D::Vector3> &source, std::vector<G3D::Vector3> &transformedVertices, float scale, G3D::Matrix3 &rotation, G3D::Vector3 &position)
     {
@@ -26,6 +26,15 @@
 #include "G3D/Vector3.h"
 #include "G3D/Matrix3.h"
 
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+namespace VMAP
+{
+    class VMapManager2;
+}
+
 namespace MMAP
 {
     enum Spot
@@ -83,6 +92,8 @@ namespace MMAP
 
             void loadMap(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData);
             bool loadVMap(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData);
+            /// Drops the models loadVMap kept in memory for the map's remaining tiles
+            void releaseVMapModels(uint32 mapID);
             void loadOffMeshConnections(uint32 mapID, uint32 tileX, uint32 tileY, MeshData &meshData, const char* offMeshFilePath);
 
             bool usesLiquids() { return !m_skipLiquid; }
@@ -104,6 +115,12 @@ namespace MMAP
             /// Controls whether liquids are loaded
             bool m_skipLiquid;
 
+            /// Model files shared by all tiles and threads, loaded models are read only
+            VMAP::VMapManager2* m_vmapManager;
+            /// Models kept loaded per map so neighbouring tiles don't read them again
+            std::unordered_map<uint32, std::set<std::string>> m_cachedModels;
+            std::mutex m_cachedModelsLock;
+
             /// Load the map terrain from file
             bool loadHeightMap(uint32 mapID, uint32 tileX, uint32 tileY, G3D::Array<float> &vertices, G3D::Array<int> &triangles, Spot portion);
 